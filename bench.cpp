@@ -0,0 +1,488 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <vector>
+#include <queue>
+#include <chrono>
+#include <random>
+#include <memory>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <thread>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "event_queue.h"
+#include "input_parser.h"
+#include "workload.h"
+#include "generator.h"
+#include "simulator.h"
+
+// Comparator for the std::priority_queue baseline
+struct EventComparator {
+    bool operator()(const Event& a, const Event& b) const {
+        return a > b;
+    }
+};
+
+typedef std::priority_queue<Event, std::vector<Event>, EventComparator> EventPriorityQueue;
+
+// Process index of the running process in the preemption benchmarks
+static const unsigned int RUNNING_PROCESS = 0;
+
+// Fill a queue with pending IO completions for distinct processes
+template <typename Queue>
+static void fillQueue(Queue& queue, int eventCount, std::mt19937& rng) {
+    std::uniform_int_distribution<int> timeDist(1, 1000000);
+    for (int i = 0; i < eventCount; ++i) {
+        queue.push(Event(timeDist(rng), static_cast<unsigned int>(i + 1), EventType::IO_BURST_COMPLETION));
+    }
+}
+
+// Preemption as done by rebuilding the whole queue without one event
+static double benchRebuild(int eventCount, int preemptions) {
+    std::mt19937 rng(42);
+    EventPriorityQueue queue;
+    fillQueue(queue, eventCount, rng);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < preemptions; ++i) {
+        queue.push(Event(500000 + i, RUNNING_PROCESS, EventType::CPU_BURST_COMPLETION));
+        EventPriorityQueue tempQueue;
+        while (!queue.empty()) {
+            Event e = queue.top();
+            queue.pop();
+            if (e.getProcess() != RUNNING_PROCESS) {
+                tempQueue.push(e);
+            }
+        }
+        queue = tempQueue;
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / preemptions;
+}
+
+// Preemption as done by cancelling the running process's event handle
+static double benchCancel(int eventCount, int preemptions) {
+    std::mt19937 rng(42);
+    HeapEventQueue queue;
+    fillQueue(queue, eventCount, rng);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < preemptions; ++i) {
+        EventQueue::Handle handle = queue.emplace(500000 + i, RUNNING_PROCESS, EventType::CPU_BURST_COMPLETION);
+        queue.cancel(handle);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / preemptions;
+}
+
+static void benchPreemption() {
+    std::cout << "# Preemption cost (ns per preemption) by pending event count" << std::endl;
+    std::cout << "events,rebuild_ns,cancel_ns" << std::endl;
+    for (int eventCount = 1000; eventCount <= 1000000; eventCount *= 10) {
+        // The rebuild path is O(n log n) per preemption, keep its runtime bounded
+        int rebuildPreemptions = std::max(5, 2000000 / eventCount);
+        double rebuild = benchRebuild(eventCount, rebuildPreemptions);
+        double cancel = benchCancel(eventCount, 1000000);
+        std::cout << eventCount << "," << std::fixed << std::setprecision(1)
+                  << rebuild << "," << cancel << std::endl;
+    }
+}
+
+// Classic hold model: pop the earliest event and push a successor a random
+// exponential distance into the future, keeping the pending count constant
+static double benchHold(const std::string& kind, int eventCount, int operations) {
+    std::mt19937 rng(42);
+    std::exponential_distribution<double> delayDist(1.0 / 500.0);
+    std::unique_ptr<EventQueue> queue = createEventQueue(kind);
+    for (int i = 0; i < eventCount; ++i) {
+        queue->emplace(static_cast<int>(delayDist(rng)), static_cast<unsigned int>(i),
+                       EventType::IO_BURST_COMPLETION);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < operations; ++i) {
+        Event event = queue->top();
+        queue->pop();
+        queue->emplace(event.getTime() + static_cast<int>(delayDist(rng)), event.getProcess(), event.getType());
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / operations;
+}
+
+static void benchEventQueues() {
+    const char* kinds[] = { "heap", "calendar", "ladder" };
+    std::cout << "# Hold model cost (ns per pop+push) by pending event count" << std::endl;
+    std::cout << "events,heap_ns,calendar_ns,ladder_ns" << std::endl;
+    for (int eventCount = 1000; eventCount <= 1000000; eventCount *= 10) {
+        std::cout << eventCount;
+        for (const char* kind : kinds) {
+            std::cout << "," << std::fixed << std::setprecision(1) << benchHold(kind, eventCount, 200000);
+        }
+        std::cout << std::endl;
+    }
+}
+
+// Write a random workload in the text input format
+static std::string makeTextWorkload(int processCount) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> burstCountDist(1, 10);
+    std::uniform_int_distribution<int> durationDist(1, 500);
+    std::ostringstream out;
+    out << processCount << " 5\n";
+    for (int i = 1; i <= processCount; ++i) {
+        int bursts = burstCountDist(rng);
+        out << i << " " << i * 10 << " " << bursts << "\n";
+        for (int b = 1; b <= bursts; ++b) {
+            out << b << " " << durationDist(rng) << " " << (b < bursts ? durationDist(rng) : 0) << "\n";
+        }
+    }
+    return out.str();
+}
+
+// The original loader: getline plus an istringstream per line
+static std::size_t parseWithStreams(std::istream& in) {
+    Workload workload;
+    std::string line;
+    int lineNum = 0;
+    int currentBurst = 0;
+    int maxBursts = 0;
+    while (std::getline(in, line)) {
+        std::istringstream iss(line);
+        if (lineNum++ == 0) {
+            continue;
+        }
+        int value1, value2, value3;
+        if (!(iss >> value1 >> value2 >> value3)) {
+            break;
+        }
+        if (currentBurst == 0) {
+            workload.addProcess(value1, value2);
+            maxBursts = value3;
+            currentBurst = 1;
+        } else {
+            workload.addBurst(BurstType::CPU, value2);
+            if (value1 < maxBursts) {
+                workload.addBurst(BurstType::IO, value3);
+            }
+            if (++currentBurst > maxBursts) {
+                currentBurst = 0;
+            }
+        }
+    }
+    return workload.size();
+}
+
+static double megabytesPerSecond(std::size_t bytes, std::chrono::steady_clock::time_point start) {
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return bytes / 1e6 / seconds;
+}
+
+static void benchParser() {
+    std::string text = makeTextWorkload(200000);
+    char path[] = "/tmp/sim_bench_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0 || write(fd, text.data(), text.size()) != static_cast<ssize_t>(text.size())) {
+        std::cerr << "Cannot write benchmark input to " << path << std::endl;
+        return;
+    }
+    close(fd);
+
+    std::cout << "# Input parsing throughput (MB/s) on a " << text.size() / 1000000 << " MB workload" << std::endl;
+    std::cout << "loader,mb_per_s" << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    std::ifstream file(path);
+    parseWithStreams(file);
+    std::cout << "getline_istringstream," << std::fixed << std::setprecision(1)
+              << megabytesPerSecond(text.size(), start) << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    fd = open(path, O_RDONLY);
+    InputParser mapped;
+    mapped.parseFile(fd);
+    close(fd);
+    std::cout << "mmap_scanner," << megabytesPerSecond(text.size(), start) << std::endl;
+
+    // Same scanner fed through a pipe, as when the input is piped into sim
+    int pipeFds[2];
+    if (pipe(pipeFds) == 0) {
+        start = std::chrono::steady_clock::now();
+        std::thread writer([&text, &pipeFds]() {
+            std::size_t written = 0;
+            while (written < text.size()) {
+                ssize_t count = write(pipeFds[1], text.data() + written, text.size() - written);
+                if (count <= 0) {
+                    break;
+                }
+                written += count;
+            }
+            close(pipeFds[1]);
+        });
+        InputParser piped;
+        piped.parseFile(pipeFds[0]);
+        writer.join();
+        close(pipeFds[0]);
+        std::cout << "block_scanner," << megabytesPerSecond(text.size(), start) << std::endl;
+    }
+    std::remove(path);
+}
+
+// The earlier process layout: a record per process owning a vector of
+// bursts, each burst carrying type, duration and remaining time
+struct VectorBurst {
+    BurstType type;
+    int duration;
+    int remainingTime;
+};
+
+struct VectorProcess {
+    int id;
+    int arrivalTime;
+    ProcessState state;
+    int currentBurstIndex;
+    std::vector<VectorBurst> bursts;
+    int core;
+    int totalServiceTime;
+    int totalIOTime;
+    int finishTime;
+    int startTime;
+    int lastStateChangeTime;
+};
+
+// Resident set size of this process in bytes
+static std::size_t residentBytes() {
+    std::ifstream statm("/proc/self/statm");
+    std::size_t pages = 0;
+    std::size_t resident = 0;
+    statm >> pages >> resident;
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+// Burst counts of the layout benchmark workload, 1 to 10 bursts per process
+static std::vector<int> layoutBurstCounts(int processCount) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> burstCountDist(1, 10);
+    std::vector<int> counts(processCount);
+    for (auto& count : counts) {
+        count = 2 * burstCountDist(rng) - 1;
+    }
+    return counts;
+}
+
+// Event-like access: touch the current burst of a random process and charge
+// it a time slice, advancing to the next burst when it runs out
+template <typename Charge>
+static double chargeBursts(int processCount, int accesses, Charge charge) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> processDist(0, processCount - 1);
+    std::vector<int> order(accesses);
+    for (auto& index : order) {
+        index = processDist(rng);
+    }
+    auto start = std::chrono::steady_clock::now();
+    long long checksum = 0;
+    for (int index : order) {
+        checksum += charge(index);
+    }
+    auto end = std::chrono::steady_clock::now();
+    if (checksum == 42) {
+        std::cout << "";
+    }
+    return std::chrono::duration<double, std::nano>(end - start).count() / accesses;
+}
+
+static void benchBurstLayout() {
+    const int processCount = 1000000;
+    const int accesses = 5000000;
+    std::vector<int> counts = layoutBurstCounts(processCount);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> durationDist(1, 500);
+
+    std::cout << "# Burst storage for " << processCount << " processes: resident bytes and ns per burst access" << std::endl;
+    std::cout << "layout,bytes_per_process,access_ns" << std::endl;
+
+    // The arena is measured first: its few large arrays go back to the
+    // system when freed, the per-process vectors mostly do not
+    {
+        std::size_t before = residentBytes();
+        Workload workload;
+        for (int i = 0; i < processCount; ++i) {
+            workload.addProcess(i + 1, i);
+            for (int b = 0; b < counts[i]; ++b) {
+                workload.addBurst(b % 2 == 0 ? BurstType::CPU : BurstType::IO, durationDist(rng));
+            }
+        }
+        std::size_t bytes = residentBytes() - before;
+        std::vector<Process>& processes = workload.getProcesses();
+        BurstArena& bursts = workload.getBursts();
+        double ns = chargeBursts(processCount, accesses, [&processes, &bursts](int index) {
+            Process& process = processes[index];
+            int burst = process.getCurrentBurst();
+            int remaining = bursts.getRemainingTime(burst) - 10;
+            if (remaining > 0) {
+                bursts.setRemainingTime(burst, remaining);
+            } else if (process.hasNextBurst()) {
+                process.moveToNextBurst();
+            } else {
+                process.setCurrentBurstIndex(0);
+            }
+            return remaining;
+        });
+        std::cout << "arena," << bytes / processCount << "," << std::fixed << std::setprecision(1) << ns << std::endl;
+    }
+
+    {
+        std::size_t before = residentBytes();
+        std::vector<VectorProcess> processes;
+        for (int i = 0; i < processCount; ++i) {
+            VectorProcess process = { i + 1, i, ProcessState::NEW, 0, std::vector<VectorBurst>(), -1, 0, 0, -1, -1, i };
+            processes.push_back(process);
+            for (int b = 0; b < counts[i]; ++b) {
+                int duration = durationDist(rng);
+                VectorBurst burst = { b % 2 == 0 ? BurstType::CPU : BurstType::IO, duration, duration };
+                processes.back().bursts.push_back(burst);
+            }
+        }
+        std::size_t bytes = residentBytes() - before;
+        double ns = chargeBursts(processCount, accesses, [&processes](int index) {
+            VectorProcess& process = processes[index];
+            VectorBurst& burst = process.bursts[process.currentBurstIndex];
+            int remaining = burst.remainingTime - 10;
+            if (remaining > 0) {
+                burst.remainingTime = remaining;
+            } else if (process.currentBurstIndex + 1 < static_cast<int>(process.bursts.size())) {
+                process.currentBurstIndex++;
+            } else {
+                process.currentBurstIndex = 0;
+            }
+            return remaining;
+        });
+        std::cout << "vector_per_process," << bytes / processCount << "," << ns << std::endl;
+    }
+}
+
+// Simulate one policy on a generated workload and print its CSV row. Runs
+// in a child process so the peak RSS is that of this run alone.
+static void benchPolicy(int processCount, const std::string& algorithm) {
+    std::cout.flush();
+    pid_t child = fork();
+    if (child < 0) {
+        std::cerr << "Cannot fork for " << algorithm << " on " << processCount << " processes" << std::endl;
+        return;
+    }
+    if (child > 0) {
+        int status;
+        waitpid(child, &status, 0);
+        return;
+    }
+
+    ProcessGenerator generator(static_cast<unsigned int>(processCount));
+    Workload workload = generator.generateProcesses(processCount, 5);
+    Simulator simulator(workload, 5);
+
+    auto start = std::chrono::steady_clock::now();
+    Statistics statistics = simulator.run(algorithm, false);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    std::cout << algorithm << "," << processCount << "," << statistics.getEventCount() << ","
+              << statistics.getDispatchCount() << "," << std::fixed << std::setprecision(0)
+              << statistics.getEventCount() / seconds << "," << std::setprecision(1)
+              << seconds * 1e9 / std::max(statistics.getDispatchCount(), 1LL) << ","
+              << usage.ru_maxrss << "," << std::setprecision(3) << seconds << std::endl;
+    _exit(0);
+}
+
+static void benchPolicies() {
+    const int processCounts[] = { 1000, 10000, 100000, 1000000 };
+    const char* algorithms[] = { "FCFS", "SJF", "SRTN", "RR10", "RR50", "RR100", "MLFQ", "CFS", "LOTTERY", "STRIDE",
+                                 "PRIO", "PPRIO", "EDF", "RM" };
+
+    std::cout << "# Simulation throughput per policy on generated workloads (seed = process count)" << std::endl;
+    std::cout << "policy,processes,events,dispatches,events_per_s,ns_per_dispatch,peak_rss_kb,wall_s" << std::endl;
+    for (int processCount : processCounts) {
+        for (const char* algorithm : algorithms) {
+            benchPolicy(processCount, algorithm);
+        }
+    }
+}
+
+// Events per second of the generic and the specialised loop on one policy,
+// best of several alternating runs so both see the same machine state
+static void compareLoops(Simulator& simulator, const std::string& algorithm, double& generic,
+                         double& specialized) {
+    generic = 0.0;
+    specialized = 0.0;
+    for (int repetition = 0; repetition < 5; ++repetition) {
+        for (int variant = 0; variant < 2; ++variant) {
+            auto start = std::chrono::steady_clock::now();
+            Statistics statistics = variant == 0 ? simulator.runGeneric(algorithm, false)
+                                                 : simulator.run(algorithm, false);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            double& best = variant == 0 ? generic : specialized;
+            best = std::max(best, statistics.getEventCount() / seconds);
+        }
+    }
+}
+
+static void benchSpecialization() {
+    const int processCount = 20000;
+    const char* algorithms[] = { "FCFS", "SJF", "SRTN", "RR10", "RR50", "RR100", "MLFQ", "CFS", "LOTTERY", "STRIDE",
+                                 "PRIO", "PPRIO", "EDF", "RM" };
+    ProcessGenerator generator(static_cast<unsigned int>(processCount));
+    Simulator simulator(generator.generateProcesses(processCount, 5), 5);
+
+    std::cout << "# Simulation loop specialised per policy against the generic loop (events/s, "
+              << processCount << " processes)" << std::endl;
+    std::cout << "policy,generic,specialized,speedup" << std::endl;
+    for (const char* algorithm : algorithms) {
+        double generic;
+        double specialized;
+        compareLoops(simulator, algorithm, generic, specialized);
+        std::cout << algorithm << "," << std::fixed << std::setprecision(0) << generic << "," << specialized
+                  << "," << std::setprecision(2) << specialized / generic << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // Suites in the order they run; any given on the command line are run alone
+    const struct {
+        const char* name;
+        void (*run)();
+    } suites[] = {
+        { "policies", benchPolicies },
+        { "specialization", benchSpecialization },
+        { "preemption", benchPreemption },
+        { "event_queues", benchEventQueues },
+        { "parser", benchParser },
+        { "burst_layout", benchBurstLayout },
+    };
+
+    for (int i = 1; i < argc; ++i) {
+        bool known = false;
+        for (const auto& suite : suites) {
+            known = known || argv[i] == std::string(suite.name);
+        }
+        if (!known) {
+            std::cerr << "Unknown benchmark: " << argv[i] << std::endl;
+            std::cerr << "Usage: sim_bench [policies|specialization|preemption|event_queues|parser|burst_layout]..." << std::endl;
+            return 1;
+        }
+    }
+    for (const auto& suite : suites) {
+        bool selected = argc == 1;
+        for (int i = 1; i < argc; ++i) {
+            selected = selected || argv[i] == std::string(suite.name);
+        }
+        if (selected) {
+            suite.run();
+        }
+    }
+    return 0;
+}
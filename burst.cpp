@@ -1,8 +0,0 @@
-#include "burst.h"
-
-Burst::Burst(BurstType type, int duration) 
-    : type(type), duration(duration), remainingTime(duration) {}
-
-void Burst::reset() {
-    remainingTime = duration;
-}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include "burst_arena.h"
+
+int BurstArena::add(BurstType type, int duration, int device) {
+    durations.push_back(duration);
+    remainingTimes.push_back(duration);
+    types.push_back(type);
+    devices.push_back(static_cast<unsigned char>(device));
+    return static_cast<int>(durations.size() - 1);
+}
+
+int BurstArena::append(const BurstArena& other, int first, int count) {
+    int index = static_cast<int>(durations.size());
+    durations.insert(durations.end(), other.durations.begin() + first, other.durations.begin() + first + count);
+    remainingTimes.insert(remainingTimes.end(), other.remainingTimes.begin() + first,
+                          other.remainingTimes.begin() + first + count);
+    types.insert(types.end(), other.types.begin() + first, other.types.begin() + first + count);
+    devices.insert(devices.end(), other.devices.begin() + first, other.devices.begin() + first + count);
+    return index;
+}
+
+void BurstArena::reserve(std::size_t count) {
+    durations.reserve(count);
+    remainingTimes.reserve(count);
+    types.reserve(count);
+    devices.reserve(count);
+}
+
+std::size_t BurstArena::size() const {
+    return durations.size();
+}
+
+void BurstArena::clear() {
+    durations.clear();
+    remainingTimes.clear();
+    types.clear();
+    devices.clear();
+}
+
+void BurstArena::reset() {
+    remainingTimes = durations;
+}
+
+std::size_t BurstArena::memoryUsage() const {
+    return durations.capacity() * sizeof(int) + remainingTimes.capacity() * sizeof(int) +
+           types.capacity() * sizeof(BurstType) + devices.capacity();
+}
@@ -0,0 +1,61 @@
+#ifndef BURST_ARENA_H
+#define BURST_ARENA_H
+
+#include <vector>
+#include <cstddef>
+#include "types.h"
+
+// Bursts of many processes in one contiguous store, kept as parallel arrays
+// so the per-event reads touch only the field they need. A process refers
+// to its bursts by the index of the first one and a count. The accessors are
+// inline since they sit on the per-event path.
+class BurstArena {
+public:
+    // Device of an I/O burst that names none; named devices are 0 to 254
+    static const unsigned char ANY_DEVICE = 255;
+
+    // Append a burst and return its index
+    int add(BurstType type, int duration, int device = ANY_DEVICE);
+
+    // Append bursts [first, first + count) of another arena, remaining times
+    // included, and return the index of the first copy
+    int append(const BurstArena& other, int first, int count);
+
+    void reserve(std::size_t count);
+    std::size_t size() const;
+    void clear();
+
+    // Restore every remaining time to the full duration
+    void reset();
+
+    BurstType getType(int index) const {
+        return types[index];
+    }
+
+    int getDuration(int index) const {
+        return durations[index];
+    }
+
+    int getRemainingTime(int index) const {
+        return remainingTimes[index];
+    }
+
+    void setRemainingTime(int index, int time) {
+        remainingTimes[index] = time;
+    }
+
+    int getDevice(int index) const {
+        return devices[index];
+    }
+
+    // Bytes held by the arrays, for footprint reports
+    std::size_t memoryUsage() const;
+
+private:
+    std::vector<int> durations;
+    std::vector<int> remainingTimes;
+    std::vector<BurstType> types;
+    std::vector<unsigned char> devices;
+};
+
+#endif // BURST_ARENA_H
@@ -0,0 +1,180 @@
+#include <algorithm>
+#include "calendar_queue.h"
+
+const std::size_t CalendarEventQueue::MIN_BUCKETS;
+
+CalendarEventQueue::CalendarEventQueue()
+    : buckets(MIN_BUCKETS),
+      bucketWidth(1),
+      count(0),
+      nextSequence(0),
+      minBucket(0),
+      minBucketTop(0) {}
+
+EventQueue::Handle CalendarEventQueue::push(const Event& event) {
+    QueuedEvent entry = { event, INVALID_HANDLE };
+    entry.event.setSequence(nextSequence++);
+    entry.handle = handles.acquire(entry.event);
+    insert(entry);
+
+    if (count > 2 * buckets.size()) {
+        resize(buckets.size() * 2);
+    }
+    return entry.handle;
+}
+
+const Event& CalendarEventQueue::top() const {
+    return buckets[minBucket].back().event;
+}
+
+void CalendarEventQueue::pop() {
+    Handle handle = buckets[minBucket].back().handle;
+    removeEntry(handle);
+    handles.release(handle);
+}
+
+bool CalendarEventQueue::cancel(Handle handle) {
+    if (!contains(handle)) {
+        return false;
+    }
+    removeEntry(handle);
+    handles.release(handle);
+    return true;
+}
+
+bool CalendarEventQueue::reschedule(Handle handle, SimTime newTime) {
+    if (!contains(handle)) {
+        return false;
+    }
+    const Event& old = handles.eventOf(handle);
+    QueuedEvent moved = { Event(newTime, old.getProcess(), old.getType(), nextSequence++), handle };
+    removeEntry(handle);
+    handles.update(handle, moved.event);
+    insert(moved);
+    return true;
+}
+
+bool CalendarEventQueue::contains(Handle handle) const {
+    return handles.isPending(handle);
+}
+
+bool CalendarEventQueue::empty() const {
+    return count == 0;
+}
+
+std::size_t CalendarEventQueue::size() const {
+    return count;
+}
+
+void CalendarEventQueue::clear() {
+    buckets.assign(MIN_BUCKETS, std::vector<QueuedEvent>());
+    bucketWidth = 1;
+    count = 0;
+    handles.clear();
+    nextSequence = 0;
+    minBucket = 0;
+    minBucketTop = 0;
+}
+
+std::size_t CalendarEventQueue::bucketOf(SimTime time) const {
+    long long slot = time >= 0 ? time / bucketWidth : -((-time + bucketWidth - 1) / bucketWidth);
+    return static_cast<std::size_t>(slot) & (buckets.size() - 1);
+}
+
+long long CalendarEventQueue::bucketTopOf(SimTime time) const {
+    long long slot = time >= 0 ? time / bucketWidth : -((-time + bucketWidth - 1) / bucketWidth);
+    return (slot + 1) * bucketWidth;
+}
+
+void CalendarEventQueue::insert(const QueuedEvent& entry) {
+    // A new earliest event moves the dequeue position back to its bucket
+    if (count == 0 || queuedBefore(entry, buckets[minBucket].back())) {
+        minBucket = bucketOf(entry.event.getTime());
+        minBucketTop = bucketTopOf(entry.event.getTime());
+    }
+
+    std::vector<QueuedEvent>& bucket = buckets[bucketOf(entry.event.getTime())];
+    auto position = std::upper_bound(bucket.begin(), bucket.end(), entry,
+        [](const QueuedEvent& a, const QueuedEvent& b) {
+            return queuedBefore(b, a);
+        });
+    bucket.insert(position, entry);
+    count++;
+}
+
+void CalendarEventQueue::removeEntry(Handle handle) {
+    std::size_t index = bucketOf(handles.eventOf(handle).getTime());
+    std::vector<QueuedEvent>& bucket = buckets[index];
+
+    // Buckets hold O(1) events on average, search from the earliest end
+    bool wasMinimum = false;
+    for (std::size_t i = bucket.size(); i-- > 0;) {
+        if (bucket[i].handle == handle) {
+            wasMinimum = index == minBucket && i + 1 == bucket.size();
+            bucket.erase(bucket.begin() + i);
+            break;
+        }
+    }
+    count--;
+
+    if (count > 0 && wasMinimum) {
+        findMinimum(minBucket, minBucketTop);
+    }
+    if (count < buckets.size() / 2 && buckets.size() > MIN_BUCKETS) {
+        resize(buckets.size() / 2);
+    }
+}
+
+void CalendarEventQueue::findMinimum(std::size_t startBucket, long long startTop) {
+    // Walk the calendar one bucket (one width of time) at a time from the
+    // previous minimum; the first bucket holding an event of the current
+    // year holds the earliest event
+    std::size_t index = startBucket;
+    long long bucketTop = startTop;
+    for (std::size_t n = 0; n < buckets.size(); ++n) {
+        const std::vector<QueuedEvent>& bucket = buckets[index];
+        if (!bucket.empty() && bucket.back().event.getTime() < bucketTop) {
+            minBucket = index;
+            minBucketTop = bucketTop;
+            return;
+        }
+        index = (index + 1) & (buckets.size() - 1);
+        bucketTop += bucketWidth;
+    }
+
+    // No event within a year: fall back to a direct search
+    const QueuedEvent* best = nullptr;
+    for (const auto& bucket : buckets) {
+        if (!bucket.empty() && (best == nullptr || queuedBefore(bucket.back(), *best))) {
+            best = &bucket.back();
+        }
+    }
+    minBucket = bucketOf(best->event.getTime());
+    minBucketTop = bucketTopOf(best->event.getTime());
+}
+
+void CalendarEventQueue::resize(std::size_t bucketCount) {
+    std::vector<QueuedEvent> entries;
+    entries.reserve(count);
+    for (auto& bucket : buckets) {
+        entries.insert(entries.end(), bucket.begin(), bucket.end());
+    }
+
+    // Width of about three average event separations keeps buckets small
+    if (entries.size() >= 2) {
+        long long minTime = entries.front().event.getTime();
+        long long maxTime = minTime;
+        for (const auto& entry : entries) {
+            minTime = std::min<long long>(minTime, entry.event.getTime());
+            maxTime = std::max<long long>(maxTime, entry.event.getTime());
+        }
+        long long width = (maxTime - minTime) / static_cast<long long>(entries.size() - 1) * 3;
+        bucketWidth = std::max(1LL, std::min(width, 1LL << 40));
+    }
+
+    buckets.assign(bucketCount, std::vector<QueuedEvent>());
+    count = 0;
+    for (const auto& entry : entries) {
+        insert(entry);
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef CALENDAR_QUEUE_H
+#define CALENDAR_QUEUE_H
+
+#include <vector>
+#include "event_queue.h"
+
+// Calendar queue (Brown, 1988): events hashed into time buckets of a fixed
+// width, each bucket kept sorted. Enqueue and dequeue are O(1) amortized
+// when the bucket width matches the event spacing; the calendar is resized
+// and the width re-estimated whenever the event count doubles or halves.
+class CalendarEventQueue : public EventQueue {
+public:
+    CalendarEventQueue();
+
+    Handle push(const Event& event) override;
+    const Event& top() const override;
+    void pop() override;
+    bool cancel(Handle handle) override;
+    bool reschedule(Handle handle, SimTime newTime) override;
+    bool contains(Handle handle) const override;
+    bool empty() const override;
+    std::size_t size() const override;
+    void clear() override;
+
+private:
+    static const std::size_t MIN_BUCKETS = 16;
+
+    // Each bucket is sorted in descending order so its earliest event is last
+    std::vector<std::vector<QueuedEvent>> buckets;
+    long long bucketWidth;
+    std::size_t count;
+    EventHandleTable handles;
+    unsigned int nextSequence;
+
+    // Position of the earliest event: its bucket and the end of its year slot
+    std::size_t minBucket;
+    long long minBucketTop;
+
+    std::size_t bucketOf(SimTime time) const;
+    long long bucketTopOf(SimTime time) const;
+    void insert(const QueuedEvent& entry);
+    void removeEntry(Handle handle);
+    void findMinimum(std::size_t startBucket, long long startTop);
+    void resize(std::size_t bucketCount);
+};
+
+#endif // CALENDAR_QUEUE_H
@@ -1,26 +1,46 @@
 #ifndef EVENT_H
 #define EVENT_H
 
-#include "process.h"
 #include "types.h"
 
+// A pending event packed into 16 bytes. Time and type share one 64-bit key
+// so events order by time, then type, with a single integer comparison; the
+// process is its index in the simulator's process table, and the sequence
+// number, assigned by the event queue, keeps events with equal time and type
+// in insertion order.
 class Event {
 public:
-    Event(int time, Process* process, EventType type);
-    
+    Event(SimTime time, unsigned int process, EventType type, unsigned int sequence = 0)
+        : key(time * TYPE_RANGE + static_cast<long long>(type)),
+          process(process),
+          sequence(sequence) {}
+
     // Getters
-    int getTime() const;
-    Process* getProcess() const;
-    EventType getType() const;
-    
-    // For sorting events by time
-    bool operator<(const Event& other) const;
-    bool operator>(const Event& other) const;
+    SimTime getTime() const { return key >> TYPE_BITS; }
+    unsigned int getProcess() const { return process; }
+    EventType getType() const { return static_cast<EventType>(key & (TYPE_RANGE - 1)); }
+    unsigned int getSequence() const { return sequence; }
+
+    void setSequence(unsigned int value) { sequence = value; }
+
+    // Order by time, event type, then sequence. Sequence numbers wrap, so
+    // they are compared modulo 2^32: events of equal time and type must be
+    // pushed less than 2^31 insertions apart.
+    bool operator<(const Event& other) const {
+        if (key != other.key) {
+            return key < other.key;
+        }
+        return static_cast<int>(sequence - other.sequence) < 0;
+    }
+    bool operator>(const Event& other) const { return other < *this; }
 
 private:
-    int time;
-    Process* process;
-    EventType type;
+    static const int TYPE_BITS = 3;
+    static const long long TYPE_RANGE = 1LL << TYPE_BITS;
+
+    long long key;              // time * 8 + type; times are limited to +-2^60
+    unsigned int process;
+    unsigned int sequence;
 };
 
-#endif // EVENT_H
\ No newline at end of file
+#endif // EVENT_H
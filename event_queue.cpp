@@ -0,0 +1,194 @@
+#include "event_queue.h"
+#include "calendar_queue.h"
+#include "ladder_queue.h"
+
+const EventQueue::Handle EventQueue::INVALID_HANDLE;
+const std::size_t HeapEventQueue::ARITY;
+
+EventQueue::Handle EventQueue::emplace(SimTime time, unsigned int process, EventType type) {
+    return push(Event(time, process, type));
+}
+
+EventQueue::Handle EventHandleTable::acquire(const Event& event) {
+    EventQueue::Handle handle;
+    if (!freeHandles.empty()) {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    } else {
+        handle = static_cast<EventQueue::Handle>(slots.size());
+        Slot slot = { event, false };
+        slots.push_back(slot);
+    }
+    update(handle, event);
+    return handle;
+}
+
+void EventHandleTable::release(EventQueue::Handle handle) {
+    slots[handle].pending = false;
+    freeHandles.push_back(handle);
+}
+
+void EventHandleTable::update(EventQueue::Handle handle, const Event& event) {
+    slots[handle].event = event;
+    slots[handle].pending = true;
+}
+
+bool EventHandleTable::isPending(EventQueue::Handle handle) const {
+    return handle >= 0 && handle < static_cast<EventQueue::Handle>(slots.size()) &&
+           slots[handle].pending;
+}
+
+bool EventHandleTable::isCurrent(const QueuedEvent& entry) const {
+    const Slot& slot = slots[entry.handle];
+    return slot.pending && slot.event.getSequence() == entry.event.getSequence();
+}
+
+const Event& EventHandleTable::eventOf(EventQueue::Handle handle) const {
+    return slots[handle].event;
+}
+
+void EventHandleTable::clear() {
+    slots.clear();
+    freeHandles.clear();
+}
+
+HeapEventQueue::HeapEventQueue() : nextSequence(0) {}
+
+EventQueue::Handle HeapEventQueue::push(const Event& event) {
+    Handle handle;
+    if (!freeHandles.empty()) {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    } else {
+        handle = static_cast<Handle>(positions.size());
+        positions.push_back(-1);
+    }
+
+    QueuedEvent node = { event, handle };
+    node.event.setSequence(nextSequence++);
+    heap.push_back(node);
+    positions[handle] = static_cast<int>(heap.size() - 1);
+    siftUp(heap.size() - 1);
+    return handle;
+}
+
+const Event& HeapEventQueue::top() const {
+    return heap.front().event;
+}
+
+void HeapEventQueue::pop() {
+    removeAt(0);
+}
+
+bool HeapEventQueue::cancel(Handle handle) {
+    if (!contains(handle)) {
+        return false;
+    }
+    removeAt(static_cast<std::size_t>(positions[handle]));
+    return true;
+}
+
+bool HeapEventQueue::reschedule(Handle handle, SimTime newTime) {
+    if (!contains(handle)) {
+        return false;
+    }
+    std::size_t index = static_cast<std::size_t>(positions[handle]);
+    const Event& old = heap[index].event;
+    heap[index].event = Event(newTime, old.getProcess(), old.getType(), nextSequence++);
+    // The node is moved either up or down, never both
+    siftUp(index);
+    siftDown(static_cast<std::size_t>(positions[handle]));
+    return true;
+}
+
+bool HeapEventQueue::contains(Handle handle) const {
+    return handle >= 0 && handle < static_cast<Handle>(positions.size()) && positions[handle] >= 0;
+}
+
+bool HeapEventQueue::empty() const {
+    return heap.empty();
+}
+
+std::size_t HeapEventQueue::size() const {
+    return heap.size();
+}
+
+void HeapEventQueue::clear() {
+    heap.clear();
+    positions.clear();
+    freeHandles.clear();
+    nextSequence = 0;
+}
+
+void HeapEventQueue::place(std::size_t index, const QueuedEvent& node) {
+    heap[index] = node;
+    positions[node.handle] = static_cast<int>(index);
+}
+
+void HeapEventQueue::siftUp(std::size_t index) {
+    QueuedEvent node = heap[index];
+    while (index > 0) {
+        std::size_t parent = (index - 1) / ARITY;
+        if (!queuedBefore(node, heap[parent])) {
+            break;
+        }
+        place(index, heap[parent]);
+        index = parent;
+    }
+    place(index, node);
+}
+
+void HeapEventQueue::siftDown(std::size_t index) {
+    QueuedEvent node = heap[index];
+    std::size_t count = heap.size();
+    while (true) {
+        std::size_t first = index * ARITY + 1;
+        if (first >= count) {
+            break;
+        }
+        std::size_t last = first + ARITY < count ? first + ARITY : count;
+        std::size_t best = first;
+        for (std::size_t child = first + 1; child < last; ++child) {
+            if (queuedBefore(heap[child], heap[best])) {
+                best = child;
+            }
+        }
+        if (!queuedBefore(heap[best], node)) {
+            break;
+        }
+        place(index, heap[best]);
+        index = best;
+    }
+    place(index, node);
+}
+
+void HeapEventQueue::removeAt(std::size_t index) {
+    Handle removed = heap[index].handle;
+    positions[removed] = -1;
+    freeHandles.push_back(removed);
+
+    std::size_t lastIndex = heap.size() - 1;
+    if (index != lastIndex) {
+        Handle moved = heap[lastIndex].handle;
+        place(index, heap[lastIndex]);
+        heap.pop_back();
+        siftUp(index);
+        siftDown(static_cast<std::size_t>(positions[moved]));
+    } else {
+        heap.pop_back();
+    }
+}
+
+bool isValidEventQueueKind(const std::string& kind) {
+    return kind == "heap" || kind == "calendar" || kind == "ladder";
+}
+
+std::unique_ptr<EventQueue> createEventQueue(const std::string& kind) {
+    if (kind == "calendar") {
+        return std::unique_ptr<EventQueue>(new CalendarEventQueue());
+    }
+    if (kind == "ladder") {
+        return std::unique_ptr<EventQueue>(new LadderEventQueue());
+    }
+    return std::unique_ptr<EventQueue>(new HeapEventQueue());
+}
@@ -0,0 +1,114 @@
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <vector>
+#include <memory>
+#include <string>
+#include <cstddef>
+#include "event.h"
+
+// Pending event set driving the simulation loop.
+//
+// Events are ordered by time, then event type; events that tie are popped
+// in insertion order, so every implementation yields exactly the same
+// sequence. Queues stamp each pushed or rescheduled event with the next
+// sequence number, making Event::operator< a strict order. Every push returns a handle that stays
+// valid until the event is popped or cancelled, so a pending event can be
+// removed or moved without rebuilding the queue.
+class EventQueue {
+public:
+    typedef int Handle;
+    static const Handle INVALID_HANDLE = -1;
+
+    virtual ~EventQueue() {}
+
+    // Insert an event and return a handle to it
+    virtual Handle push(const Event& event) = 0;
+    Handle emplace(SimTime time, unsigned int process, EventType type);
+
+    // Access and remove the earliest event
+    virtual const Event& top() const = 0;
+    virtual void pop() = 0;
+
+    // Remove a pending event; returns false if the handle is not pending
+    virtual bool cancel(Handle handle) = 0;
+
+    // Move a pending event to a new time; returns false if not pending
+    virtual bool reschedule(Handle handle, SimTime newTime) = 0;
+
+    virtual bool contains(Handle handle) const = 0;
+    virtual bool empty() const = 0;
+    virtual std::size_t size() const = 0;
+    virtual void clear() = 0;
+};
+
+// Event together with its handle (24 bytes)
+struct QueuedEvent {
+    Event event;
+    EventQueue::Handle handle;
+};
+
+// Strict ordering of queued events: time, event type, then insertion order
+inline bool queuedBefore(const QueuedEvent& a, const QueuedEvent& b) {
+    return a.event < b.event;
+}
+
+// Handle allocation for queues that locate entries by their event
+class EventHandleTable {
+public:
+    EventQueue::Handle acquire(const Event& event);
+    void release(EventQueue::Handle handle);
+    void update(EventQueue::Handle handle, const Event& event);
+    bool isPending(EventQueue::Handle handle) const;
+
+    // Whether an entry is the handle's current event rather than a stale copy
+    bool isCurrent(const QueuedEvent& entry) const;
+    const Event& eventOf(EventQueue::Handle handle) const;
+    void clear();
+
+private:
+    struct Slot {
+        Event event;
+        bool pending;
+    };
+
+    std::vector<Slot> slots;
+    std::vector<EventQueue::Handle> freeHandles;
+};
+
+// Indexed 4-ary min-heap; O(log n) push, pop, cancel and reschedule
+class HeapEventQueue : public EventQueue {
+public:
+    HeapEventQueue();
+
+    Handle push(const Event& event) override;
+    const Event& top() const override;
+    void pop() override;
+    bool cancel(Handle handle) override;
+    bool reschedule(Handle handle, SimTime newTime) override;
+    bool contains(Handle handle) const override;
+    bool empty() const override;
+    std::size_t size() const override;
+    void clear() override;
+
+private:
+    static const std::size_t ARITY = 4;
+
+    std::vector<QueuedEvent> heap;
+    std::vector<int> positions;     // heap index per handle, -1 when free
+    std::vector<Handle> freeHandles;
+    unsigned int nextSequence;
+
+    void place(std::size_t index, const QueuedEvent& node);
+    void siftUp(std::size_t index);
+    void siftDown(std::size_t index);
+    void removeAt(std::size_t index);
+};
+
+// Names accepted by createEventQueue
+bool isValidEventQueueKind(const std::string& kind);
+
+// Create an event queue by name ("heap", "calendar" or "ladder")
+std::unique_ptr<EventQueue> createEventQueue(const std::string& kind);
+
+#endif // EVENT_QUEUE_H
@@ -1,73 +1,205 @@
-#include <ctime>
 #include <cmath>
+#include <deque>
+#include <future>
+#include <random>
+#include <sstream>
+#include <algorithm>
 #include "generator.h"
+#include "workload_format.h"
+#include "thread_pool.h"
+
+// Blocks generated ahead of the one being written, per thread
+static const std::size_t BLOCKS_AHEAD_PER_THREAD = 2;
 
 ProcessGenerator::ProcessGenerator()
-    : rng(std::random_device{}()),
-      arrivalDist(1.0 / 50.0),  // Mean of 50 time units
-      cpuBurstDist(5, 500),     // 5 to 500 time units
-      ioBurstDist(30, 1000),    // 30 to 1000 time units
-      burstCountDist(20.0, 5.0) // Mean of 20 bursts with standard deviation of 5
-{}
-
-std::vector<Process> ProcessGenerator::generateProcesses(int count, int processSwitchOverhead) {
-    std::vector<Process> processes;
-    
-    int currentArrivalTime = 0;
-    
-    for (int i = 1; i <= count; ++i) {
-        // Generate arrival time
-        currentArrivalTime += generateArrivalTime(currentArrivalTime);
-        
-        // Create the process
-        Process process(i, currentArrivalTime);
-        
-        // Generate bursts
-        int burstCount = generateBurstCount();
-        
-        // Ensure odd number of bursts (ending with CPU)
-        if (burstCount % 2 == 0) {
-            burstCount++;
+    : ProcessGenerator(std::random_device{}()) {}
+
+ProcessGenerator::ProcessGenerator(unsigned long long seed, const WorkloadModel& model)
+    : seed(seed), model(model) {}
+
+Workload ProcessGenerator::generateProcesses(int count, int processSwitchOverhead) {
+    preparePhases(count);
+    Workload workload;
+    generateBlock(1, count, 0, workload);
+    return workload;
+}
+
+bool ProcessGenerator::writeProcesses(int count, int processSwitchOverhead, Format format, std::ostream& out,
+                                      int threadCount, std::string& error) {
+    // Arrival times and burst positions of a block depend on every block
+    // before it. Interarrival times and burst counts have streams of their
+    // own, so a first pass sums them per block without drawing any burst.
+    preparePhases(count);
+    int blockCount = (count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    std::vector<SimTime> blockArrivals(blockCount + 1, 0);      // Arrival before each block
+    std::vector<unsigned long long> blockBursts(blockCount + 1, 0);
+    ThreadPool pool(threadCount);
+    {
+        std::vector<std::future<void>> sums;
+        for (int b = 0; b < blockCount; ++b) {
+            sums.push_back(pool.submit([this, b, count, &blockArrivals, &blockBursts]() {
+                int first = b * BLOCK_SIZE + 1;
+                int last = std::min(count, first + BLOCK_SIZE - 1);
+                for (int id = first; id <= last; ++id) {
+                    blockArrivals[b + 1] += generateArrivalTime(id);
+                    blockBursts[b + 1] += generateBurstCount(id);
+                }
+            }));
         }
-        
-        // Add CPU and IO bursts alternating
-        for (int j = 0; j < burstCount; ++j) {
-            if (j % 2 == 0) {
-                // CPU burst
-                process.addCPUBurst(generateCPUBurst());
-            } else {
-                // IO burst
-                process.addIOBurst(generateIOBurst());
-            }
+        for (auto& sum : sums) {
+            sum.get();
+        }
+    }
+    for (int b = 0; b < blockCount; ++b) {
+        blockArrivals[b + 1] += blockArrivals[b];
+        blockBursts[b + 1] += blockBursts[b];
+    }
+
+    BinaryWorkloadHeader header = { processSwitchOverhead, 8, 4, 4, 4, 1, static_cast<unsigned long long>(count),
+                                    blockBursts[blockCount] };
+    if (format == Format::TEXT) {
+        out << count << " " << processSwitchOverhead << "\n";
+    } else {
+        BinaryWorkload::writeHeader(out, header);
+    }
+
+    // Blocks are generated ahead on the pool (text is formatted there too)
+    // and written in order; the window bounds the memory in use
+    struct Block {
+        Workload workload;
+        std::string text;
+    };
+    std::size_t window = BLOCKS_AHEAD_PER_THREAD * pool.getThreadCount();
+    std::deque<std::future<Block>> pending;
+    int submitted = 0;
+    for (int written = 0; written < blockCount; ++written) {
+        while (submitted < blockCount && pending.size() < window) {
+            int b = submitted++;
+            pending.push_back(pool.submit([this, b, count, format, &blockArrivals]() {
+                Block block;
+                int first = b * BLOCK_SIZE + 1;
+                generateBlock(first, std::min(BLOCK_SIZE, count - first + 1), blockArrivals[b], block.workload);
+                if (format == Format::TEXT) {
+                    std::ostringstream text;
+                    TextWorkload::writeProcesses(text, block.workload);
+                    block.text = text.str();
+                    block.workload.clear();
+                }
+                return block;
+            }));
+        }
+
+        Block block = pending.front().get();
+        pending.pop_front();
+        if (format == Format::TEXT) {
+            out.write(block.text.data(), block.text.size());
+        } else {
+            BinaryWorkload::writeBlock(out, header, block.workload,
+                                       static_cast<unsigned long long>(written) * BLOCK_SIZE, blockBursts[written]);
+        }
+        if (!out) {
+            break;
+        }
+    }
+
+    out.flush();
+    if (!out) {
+        error = "Error writing generated processes";
+        return false;
+    }
+    return true;
+}
+
+void ProcessGenerator::preparePhases(int count) {
+    // Phases alternate, each lasting a geometric number of arrivals; only the
+    // phase boundaries are stored, one draw per phase
+    phaseStarts.clear();
+    if (!model.isModulated()) {
+        return;
+    }
+    long long start = 1;
+    for (unsigned long long phase = 0; start <= count; ++phase) {
+        double mean = model.getPhaseLength(static_cast<int>(phase % 2));
+        CounterRandom random(seed, phase, PHASE);
+        double length = 1.0;
+        if (mean > 1.0) {
+            length += std::floor(std::log(1.0 - random.nextUnit()) / std::log(1.0 - 1.0 / mean));
+        }
+        start += static_cast<long long>(std::min(length, static_cast<double>(count)));
+        if (start <= count) {
+            phaseStarts.push_back(static_cast<int>(start));
         }
-        
-        processes.push_back(process);
     }
-    
-    return processes;
 }
 
-int ProcessGenerator::generateArrivalTime(int previousArrival) {
-    // Generate next interarrival time using exponential distribution
-    return static_cast<int>(arrivalDist(rng));
+int ProcessGenerator::phaseOf(int process) const {
+    std::size_t phase = std::upper_bound(phaseStarts.begin(), phaseStarts.end(), process) - phaseStarts.begin();
+    return static_cast<int>(phase % 2);
 }
 
-int ProcessGenerator::generateCPUBurst() {
-    return cpuBurstDist(rng);
+// Truncate a sample to an integer in [minimum, maximum]
+static int toDuration(double value, int minimum, int maximum) {
+    if (!(value >= minimum)) {
+        return minimum;
+    }
+    return value >= maximum ? maximum : static_cast<int>(value);
 }
 
-int ProcessGenerator::generateIOBurst() {
-    return ioBurstDist(rng);
+int ProcessGenerator::generateArrivalTime(int process) const {
+    // Generate next interarrival time
+    CounterRandom random(seed, process, ARRIVAL);
+    const Distribution& interarrival = model.isModulated() ? model.getPhaseArrival(phaseOf(process))
+                                                           : model.getArrival();
+    return toDuration(interarrival.sample(random), 0, MAX_DURATION);
 }
 
-int ProcessGenerator::generateBurstCount() {
-    // Generate number of bursts with normal distribution, but ensure minimum of 1
-    int count = std::max(1, static_cast<int>(std::round(burstCountDist(rng))));
-    
+int ProcessGenerator::generateBurstCount(int process) const {
+    // Generate number of bursts, but ensure minimum of 1
+    CounterRandom random(seed, process, BURST_COUNT);
+    int count = toDuration(std::round(model.getBurstCount().sample(random)), 1, MAX_BURST_COUNT - 1);
+
     // Ensure odd number (ends with CPU burst)
     if (count % 2 == 0) {
         count++;
     }
-    
+
     return count;
-}
\ No newline at end of file
+}
+
+void ProcessGenerator::generateBlock(int first, int count, SimTime previousArrival, Workload& workload) const {
+    SimTime currentArrivalTime = previousArrival;
+
+    for (int id = first; id < first + count; ++id) {
+        // Generate arrival time
+        currentArrivalTime += generateArrivalTime(id);
+
+        // Create the process
+        workload.addProcess(id, currentArrivalTime);
+
+        // Add CPU and IO bursts alternating
+        CounterRandom random(seed, id, BURSTS);
+        int burstCount = generateBurstCount(id);
+        for (int j = 0; j < burstCount; ++j) {
+            if (j % 2 == 0) {
+                // CPU burst
+                workload.addBurst(BurstType::CPU, toDuration(model.getCpuBurst().sample(random), 1, MAX_DURATION));
+            } else {
+                // IO burst, its device drawn after it (a constant draws
+                // nothing, so the bursts stay as they were)
+                int duration = toDuration(model.getIoBurst().sample(random), 1, MAX_DURATION);
+                int device = toDuration(std::round(model.getIoDevice().sample(random)), -1,
+                                        BurstArena::ANY_DEVICE - 1);
+                workload.addBurst(BurstType::IO, duration, device < 0 ? BurstArena::ANY_DEVICE : device);
+            }
+        }
+        
+        // Share, priority, deadline and period drawn after the bursts, so
+        // constant ones leave them as they were
+        Process& process = workload.getProcesses().back();
+        process.setWeight(toDuration(std::round(model.getShare().sample(random)), 1, Process::MAX_WEIGHT));
+        process.setPriority(toDuration(std::round(model.getPriority().sample(random)), 0,
+                                       Process::PRIORITY_LEVELS - 1));
+        process.setDeadline(toDuration(model.getDeadline().sample(random), 0, MAX_DURATION));
+        process.setPeriod(toDuration(model.getPeriod().sample(random), 0, MAX_DURATION));
+    }
+}
@@ -1,37 +1,64 @@
 #ifndef GENERATOR_H
 #define GENERATOR_H
 
+#include <string>
 #include <vector>
-#include <random>
-#include "process.h"
+#include <ostream>
+#include "workload.h"
+#include "workload_model.h"
 
+// Random workloads drawn from a WorkloadModel (by default exponential
+// interarrival times, uniform CPU and I/O bursts and a normal burst count).
+// Process i is a pure function of the seed and i, so a seed always yields
+// the same workload, however it is split across threads.
 class ProcessGenerator {
 public:
+    enum class Format { TEXT, BINARY };
+
     ProcessGenerator();
-    
+
+    // Reproducible generator: the same seed always yields the same processes
+    explicit ProcessGenerator(unsigned long long seed, const WorkloadModel& model = WorkloadModel());
+
     // Generate random processes
-    std::vector<Process> generateProcesses(int count, int processSwitchOverhead);
-    
+    Workload generateProcesses(int count, int processSwitchOverhead);
+
+    // Generate random processes straight to a stream, a block at a time on
+    // the given number of threads, so memory stays bounded by a few blocks
+    // whatever the count. Binary output must be seekable (each block writes
+    // into every column). Returns false with a message in error if writing
+    // fails.
+    bool writeProcesses(int count, int processSwitchOverhead, Format format, std::ostream& out, int threadCount,
+                        std::string& error);
+
 private:
-    std::mt19937 rng; // Mersenne Twister random number generator
-    
-    // Distribution functions
-    std::exponential_distribution<double> arrivalDist;
-    std::uniform_int_distribution<int> cpuBurstDist;
-    std::uniform_int_distribution<int> ioBurstDist;
-    std::normal_distribution<double> burstCountDist;
-    
-    // Generate exponential distribution for arrival times
-    int generateArrivalTime(int previousArrival);
-    
-    // Generate CPU burst duration
-    int generateCPUBurst();
-    
-    // Generate IO burst duration
-    int generateIOBurst();
-    
+    // Processes per block; fixed so the output never depends on the threads
+    static const int BLOCK_SIZE = 1 << 16;
+
+    // Samples are clamped to these, the fields are 32-bit
+    static const int MAX_DURATION = 1 << 30;
+    static const int MAX_BURST_COUNT = 1 << 16;
+
+    // Random streams of one process; PHASE streams are per arrival phase
+    enum Stream { ARRIVAL, BURST_COUNT, BURSTS, PHASE };
+
+    unsigned long long seed;
+    WorkloadModel model;
+    std::vector<int> phaseStarts;   // First process of every arrival phase after the first
+
+    // Lay out the arrival phases of a modulated model over count processes
+    void preparePhases(int count);
+    int phaseOf(int process) const;
+
+    // Generate the interarrival time before a process
+    int generateArrivalTime(int process) const;
+
     // Generate number of bursts per process (always odd to end with CPU)
-    int generateBurstCount();
+    int generateBurstCount(int process) const;
+
+    // Append processes [first, first + count) to a workload, the first one
+    // arriving after previousArrival
+    void generateBlock(int first, int count, SimTime previousArrival, Workload& workload) const;
 };
 
-#endif // GENERATOR_H
\ No newline at end of file
+#endif // GENERATOR_H
@@ -0,0 +1,259 @@
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "input_parser.h"
+#include "workload_format.h"
+
+// Read size for non-seekable input; grows if a single line is longer
+static const std::size_t BLOCK_SIZE = 1 << 20;
+
+// Upper bound on capacity reserved from the process count declared in the
+// input, so a corrupt header cannot trigger a huge allocation
+static const int MAX_RESERVED_PROCESSES = 1 << 20;
+
+static inline bool isBlank(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// Scan one integer the way operator>> does: skip whitespace, optional sign,
+// at least one digit, stop at the first non-digit. Fails on overflow.
+static inline bool scanLong(const char*& p, const char* end, long long& value) {
+    while (p != end && isBlank(*p)) {
+        ++p;
+    }
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+    if (p == end || *p < '0' || *p > '9') {
+        return false;
+    }
+    const unsigned long long limit = static_cast<unsigned long long>(LLONG_MAX) + 1;
+    unsigned long long result = 0;
+    while (p != end && *p >= '0' && *p <= '9') {
+        unsigned int digit = *p - '0';
+        if (result > (limit - digit) / 10) {
+            return false;
+        }
+        result = result * 10 + digit;
+        ++p;
+    }
+    if (!negative && result == limit) {
+        return false;
+    }
+    value = negative ? static_cast<long long>(0 - result) : static_cast<long long>(result);
+    return true;
+}
+
+static inline bool scanInt(const char*& p, const char* end, int& value) {
+    long long result;
+    if (!scanLong(p, end, result) || result < INT_MIN || result > INT_MAX) {
+        return false;
+    }
+    value = static_cast<int>(result);
+    return true;
+}
+
+InputParser::InputParser(bool streaming)
+    : processSwitchOverhead(0), binaryInput(false), streaming(streaming), lineNumber(0), maxBursts(0), currentBurst(0) {}
+
+bool InputParser::parseFile(int fd) {
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0 &&
+        lseek(fd, 0, SEEK_CUR) == 0) {
+        std::size_t size = static_cast<std::size_t>(info.st_size);
+        void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            madvise(data, size, MADV_SEQUENTIAL);
+            bool parsed = parseBuffer(static_cast<const char*>(data), size);
+            munmap(data, size);
+            return parsed;
+        }
+    }
+    return parseBlocks(fd);
+}
+
+bool InputParser::parseBuffer(const char* data, std::size_t size) {
+    if (BinaryWorkload::matches(data, size)) {
+        binaryInput = true;
+        return BinaryWorkload::decode(data, size, workload, processSwitchOverhead, error);
+    }
+    const char* consumed;
+    return parseLines(data, data + size, true, consumed);
+}
+
+Workload& InputParser::getWorkload() {
+    return workload;
+}
+
+int InputParser::getProcessSwitchOverhead() const {
+    return processSwitchOverhead;
+}
+
+const std::string& InputParser::getError() const {
+    return error;
+}
+
+bool InputParser::isBinaryInput() const {
+    return binaryInput;
+}
+
+bool InputParser::isProcessComplete() const {
+    return !workload.empty() && currentBurst == 0;
+}
+
+bool InputParser::parseBlocks(int fd) {
+    std::vector<char> buffer(BLOCK_SIZE);
+    std::size_t pending = 0; // Bytes of an unfinished line kept at the front
+    bool binary = false;
+    bool formatKnown = false;
+
+    while (true) {
+        if (pending == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        ssize_t count = read(fd, buffer.data() + pending, buffer.size() - pending);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            error = std::string("Error reading input: ") + std::strerror(errno);
+            return false;
+        }
+
+        // Look at the first bytes to tell binary from text input; a binary
+        // workload is read whole and decoded at the end
+        if (!formatKnown) {
+            if (pending + count < BinaryWorkload::MAGIC_SIZE && count != 0) {
+                pending += count;
+                continue;
+            }
+            formatKnown = true;
+            binary = BinaryWorkload::matches(buffer.data(), pending + count);
+        }
+        if (binary) {
+            pending += count;
+            if (count == 0) {
+                return parseBuffer(buffer.data(), pending);
+            }
+            continue;
+        }
+
+        const char* begin = buffer.data();
+        const char* end = begin + pending + count;
+        const char* consumed;
+        if (!parseLines(begin, end, count == 0, consumed)) {
+            return false;
+        }
+        if (count == 0) {
+            return true;
+        }
+        pending = end - consumed;
+        std::memmove(buffer.data(), consumed, pending);
+    }
+}
+
+bool InputParser::parseLines(const char* begin, const char* end, bool endOfInput, const char*& consumed) {
+    const char* line = begin;
+    while (line != end) {
+        const char* newline = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        if (newline == nullptr) {
+            break;
+        }
+        if (!parseLine(line, newline)) {
+            return false;
+        }
+        line = newline + 1;
+    }
+    if (endOfInput && line != end) {
+        if (!parseLine(line, end)) {
+            return false;
+        }
+        line = end;
+    }
+    consumed = line;
+    return true;
+}
+
+bool InputParser::parseLine(const char* begin, const char* end) {
+    const char* p = begin;
+    lineNumber++;
+
+    if (lineNumber == 1) {
+        // First line: number of processes and process switch overhead
+        int numProcesses = 0;
+        if (scanInt(p, end, numProcesses)) {
+            scanInt(p, end, processSwitchOverhead);
+            if (numProcesses > 0 && !streaming) {
+                workload.reserve(std::min(numProcesses, MAX_RESERVED_PROCESSES), 0);
+            }
+        }
+        return true;
+    }
+
+    // The middle field is an arrival time on process lines, so it may be 64-bit
+    int value1, value3;
+    long long value2;
+    if (!scanInt(p, end, value1) || !scanLong(p, end, value2) || !scanInt(p, end, value3) ||
+        (currentBurst != 0 && (value2 < INT_MIN || value2 > INT_MAX))) {
+        error = "Error parsing line " + std::to_string(lineNumber) + ": " + std::string(begin, end);
+        return false;
+    }
+
+    if (currentBurst == 0) {
+        // Process definition line (process number, arrival time, number of
+        // bursts), optionally followed by the process's tickets or weight,
+        // its priority, its relative deadline and its period
+        int weight = Process::DEFAULT_WEIGHT;
+        int priority = 0;
+        int deadline = 0;
+        int period = 0;
+        if (scanInt(p, end, weight) && (weight < 1 || weight > Process::MAX_WEIGHT)) {
+            error = "Error parsing line " + std::to_string(lineNumber) + ": share must be between 1 and " +
+                    std::to_string(Process::MAX_WEIGHT) + ": " + std::string(begin, end);
+            return false;
+        }
+        if (scanInt(p, end, priority) && (priority < 0 || priority >= Process::PRIORITY_LEVELS)) {
+            error = "Error parsing line " + std::to_string(lineNumber) + ": priority must be between 0 and " +
+                    std::to_string(Process::PRIORITY_LEVELS - 1) + ": " + std::string(begin, end);
+            return false;
+        }
+        if ((scanInt(p, end, deadline) && deadline < 0) || (scanInt(p, end, period) && period < 0)) {
+            error = "Error parsing line " + std::to_string(lineNumber) +
+                    ": deadline and period must not be negative: " + std::string(begin, end);
+            return false;
+        }
+        maxBursts = value3;
+        Process& process = workload.addProcess(value1, value2);
+        process.setWeight(weight);
+        process.setPriority(priority);
+        process.setDeadline(deadline);
+        process.setPeriod(period);
+        currentBurst = 1;
+    } else {
+        // Burst definition line (burst number, CPU time, IO time), optionally
+        // followed by the device of the IO burst; the last burst of a process
+        // has no IO phase
+        int device = BurstArena::ANY_DEVICE;
+        if (scanInt(p, end, device) && (device < 0 || device >= BurstArena::ANY_DEVICE)) {
+            error = "Error parsing line " + std::to_string(lineNumber) + ": device must be between 0 and " +
+                    std::to_string(BurstArena::ANY_DEVICE - 1) + ": " + std::string(begin, end);
+            return false;
+        }
+        workload.addBurst(BurstType::CPU, static_cast<int>(value2));
+        if (value1 < maxBursts) {
+            workload.addBurst(BurstType::IO, value3, device);
+        }
+
+        currentBurst++;
+        if (currentBurst > maxBursts) {
+            currentBurst = 0;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,60 @@
+#ifndef INPUT_PARSER_H
+#define INPUT_PARSER_H
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include "workload.h"
+
+// Workload loader. Text input is scanned in place from a memory-mapped file
+// or from large blocks read off a pipe, without building a string or stream
+// per line; binary workloads (see BinaryWorkload) are recognised by their
+// magic and decoded directly.
+class InputParser {
+public:
+    // A streaming parser only ever holds the process being read, so it does
+    // not reserve room for the process count declared in the header
+    explicit InputParser(bool streaming = false);
+
+    // Parse everything readable from a file descriptor; regular files are
+    // mapped, anything else is read in blocks. Returns false on the first
+    // malformed line (see getError).
+    bool parseFile(int fd);
+
+    // Parse a complete input held in memory
+    bool parseBuffer(const char* data, std::size_t size);
+
+    Workload& getWorkload();
+    int getProcessSwitchOverhead() const;
+    const std::string& getError() const;
+
+    // True if the input was a binary workload
+    bool isBinaryInput() const;
+
+    // Incremental use: parse one text line given without its newline
+    bool parseLine(const char* begin, const char* end);
+
+    // True once the last process read has all of its declared bursts
+    bool isProcessComplete() const;
+
+private:
+    Workload workload;
+    int processSwitchOverhead;
+    std::string error;
+    bool binaryInput;
+    bool streaming;
+
+    // Parser state carried between lines (and between blocks)
+    int lineNumber;
+    int maxBursts;
+    int currentBurst;
+
+    bool parseBlocks(int fd);
+
+    // Parse every complete line in [begin, end); the position after the last
+    // newline is stored in consumed. At end of input a trailing line without
+    // a newline is parsed as well.
+    bool parseLines(const char* begin, const char* end, bool endOfInput, const char*& consumed);
+};
+
+#endif // INPUT_PARSER_H
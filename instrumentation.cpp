@@ -0,0 +1,78 @@
+#include <iomanip>
+#include "instrumentation.h"
+
+static const char* const SECTION_NAMES[] = {
+    "arrival_handler",
+    "cpu_burst_completion_handler",
+    "io_burst_completion_handler",
+    "time_slice_expiration_handler",
+    "dispatch",
+    "preemption_check"
+};
+
+static const char* const EVENT_NAMES[] = {
+    "process_arrival",
+    "cpu_burst_completion",
+    "io_burst_completion",
+    "time_slice_expiration",
+    "process_terminated"
+};
+
+static void writeDepths(std::ostream& out, const char* name, const LatencyHistogram& depths) {
+    out << "\"" << name << "\":{\"samples\":" << depths.getCount()
+        << ",\"mean\":" << std::fixed << std::setprecision(2) << depths.getMean()
+        << ",\"p50\":" << depths.getPercentile(50) << ",\"p90\":" << depths.getPercentile(90)
+        << ",\"p99\":" << depths.getPercentile(99) << ",\"max\":" << depths.getMax() << "}";
+}
+
+Instrumentation::Instrumentation() : preemptions(0), contextSwitches(0) {
+    for (auto& count : events) {
+        count = 0;
+    }
+    for (auto& timer : timers) {
+        timer.calls = 0;
+        timer.nanoseconds = 0;
+    }
+}
+
+void Instrumentation::countEvent(EventType type) {
+    events[static_cast<int>(type)]++;
+}
+
+void Instrumentation::countPreemption() {
+    preemptions++;
+}
+
+void Instrumentation::countContextSwitch() {
+    contextSwitches++;
+}
+
+void Instrumentation::recordReadyQueueDepth(std::size_t depth) {
+    readyQueueDepths.record(static_cast<int>(depth));
+}
+
+void Instrumentation::recordEventQueueDepth(std::size_t depth) {
+    eventQueueDepths.record(static_cast<int>(depth));
+}
+
+Instrumentation::Timer& Instrumentation::getTimer(Section section) {
+    return timers[section];
+}
+
+void Instrumentation::writeJson(std::ostream& out, const std::string& algorithm) const {
+    out << "{\"algorithm\":\"" << algorithm << "\",\"events\":{";
+    for (int i = 0; i < EVENT_TYPE_COUNT; ++i) {
+        out << (i == 0 ? "" : ",") << "\"" << EVENT_NAMES[i] << "\":" << events[i];
+    }
+    out << "},\"preemptions\":" << preemptions << ",\"context_switches\":" << contextSwitches
+        << ",\"timers\":{";
+    for (int i = 0; i < SECTION_COUNT; ++i) {
+        out << (i == 0 ? "" : ",") << "\"" << SECTION_NAMES[i] << "\":{\"calls\":" << timers[i].calls
+            << ",\"ns\":" << timers[i].nanoseconds << "}";
+    }
+    out << "},";
+    writeDepths(out, "ready_queue_depth", readyQueueDepths);
+    out << ",";
+    writeDepths(out, "event_queue_depth", eventQueueDepths);
+    out << "}" << std::endl;
+}
@@ -0,0 +1,86 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <chrono>
+#include <string>
+#include <ostream>
+#include <cstddef>
+#include "types.h"
+#include "latency_histogram.h"
+
+// Counters, section timers and queue-depth distributions of one simulation
+// run. The simulator only feeds them when built with SIM_INSTRUMENT (make
+// INSTRUMENT=1); otherwise the INSTRUMENT macros below expand to nothing and
+// the hot path carries no cost.
+class Instrumentation {
+public:
+    // Timed sections of the simulation loop
+    enum Section {
+        ARRIVAL_HANDLER,
+        CPU_BURST_COMPLETION_HANDLER,
+        IO_BURST_COMPLETION_HANDLER,
+        TIME_SLICE_EXPIRATION_HANDLER,
+        DISPATCH,               // Selecting and starting the next process, stealing included
+        PREEMPTION_CHECK,
+        SECTION_COUNT
+    };
+
+    // Calls and accumulated wall time of one section
+    struct Timer {
+        long long calls;
+        long long nanoseconds;
+    };
+
+    Instrumentation();
+
+    void countEvent(EventType type);
+    void countPreemption();
+    void countContextSwitch();
+
+    // Sampled once per event: the ready queue of every CPU and the event queue
+    void recordReadyQueueDepth(std::size_t depth);
+    void recordEventQueueDepth(std::size_t depth);
+
+    Timer& getTimer(Section section);
+
+    // One JSON object on a single line
+    void writeJson(std::ostream& out, const std::string& algorithm) const;
+
+private:
+    static const int EVENT_TYPE_COUNT = static_cast<int>(EventType::PROCESS_TERMINATED) + 1;
+
+    long long events[EVENT_TYPE_COUNT];
+    long long preemptions;
+    long long contextSwitches;
+    Timer timers[SECTION_COUNT];
+    LatencyHistogram readyQueueDepths;
+    LatencyHistogram eventQueueDepths;
+};
+
+// Adds the lifetime of a scope to a timer
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Instrumentation::Timer& timer)
+        : timer(timer), start(std::chrono::steady_clock::now()) {}
+
+    ~ScopedTimer() {
+        timer.calls++;
+        timer.nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+
+private:
+    Instrumentation::Timer& timer;
+    std::chrono::steady_clock::time_point start;
+};
+
+#ifdef SIM_INSTRUMENT
+#define INSTRUMENT(...) __VA_ARGS__
+#define INSTRUMENT_SCOPE(instrumentation, section) \
+    ScopedTimer instrumentedScope((instrumentation).getTimer(Instrumentation::section))
+#else
+#define INSTRUMENT(...)
+#define INSTRUMENT_SCOPE(instrumentation, section)
+#endif
+
+#endif // INSTRUMENTATION_H
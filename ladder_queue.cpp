@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <climits>
+#include "ladder_queue.h"
+
+const std::size_t LadderEventQueue::THRESHOLD;
+const std::size_t LadderEventQueue::MAX_RUNGS;
+
+// Descending order so the earliest event sits at the back of a vector
+static bool queuedAfter(const QueuedEvent& a, const QueuedEvent& b) {
+    return queuedBefore(b, a);
+}
+
+LadderEventQueue::LadderEventQueue()
+    : topMin(0),
+      topMax(0),
+      topStart(LLONG_MIN),
+      count(0),
+      nextSequence(0) {}
+
+EventQueue::Handle LadderEventQueue::push(const Event& event) {
+    QueuedEvent entry = { event, INVALID_HANDLE };
+    entry.event.setSequence(nextSequence++);
+    entry.handle = handles.acquire(entry.event);
+    insert(entry);
+    count++;
+    settle();
+    return entry.handle;
+}
+
+const Event& LadderEventQueue::top() const {
+    return bottom.back().event;
+}
+
+void LadderEventQueue::pop() {
+    handles.release(bottom.back().handle);
+    bottom.pop_back();
+    count--;
+    settle();
+}
+
+bool LadderEventQueue::cancel(Handle handle) {
+    if (!contains(handle)) {
+        return false;
+    }
+    // The entry stays behind as a tombstone
+    handles.release(handle);
+    count--;
+    settle();
+    return true;
+}
+
+bool LadderEventQueue::reschedule(Handle handle, SimTime newTime) {
+    if (!contains(handle)) {
+        return false;
+    }
+    const Event& old = handles.eventOf(handle);
+    QueuedEvent moved = { Event(newTime, old.getProcess(), old.getType(), nextSequence++), handle };
+    // Re-pointing the handle turns the old entry into a tombstone
+    handles.update(handle, moved.event);
+    insert(moved);
+    settle();
+    return true;
+}
+
+bool LadderEventQueue::contains(Handle handle) const {
+    return handles.isPending(handle);
+}
+
+bool LadderEventQueue::empty() const {
+    return count == 0;
+}
+
+std::size_t LadderEventQueue::size() const {
+    return count;
+}
+
+void LadderEventQueue::clear() {
+    topEvents.clear();
+    topMin = 0;
+    topMax = 0;
+    topStart = LLONG_MIN;
+    rungs.clear();
+    bottom.clear();
+    count = 0;
+    handles.clear();
+    nextSequence = 0;
+}
+
+void LadderEventQueue::insert(const QueuedEvent& entry) {
+    long long time = entry.event.getTime();
+
+    if (time >= topStart) {
+        if (topEvents.empty()) {
+            topMin = time;
+            topMax = time;
+        } else {
+            topMin = std::min(topMin, time);
+            topMax = std::max(topMax, time);
+        }
+        topEvents.push_back(entry);
+        return;
+    }
+
+    // Rungs are ordered from widest to narrowest; each one covers the time
+    // range just before the current bucket of the rung above it
+    for (auto& rung : rungs) {
+        if (time >= rung.currentStart()) {
+            std::size_t index = static_cast<std::size_t>((time - rung.start) / rung.width);
+            rung.buckets[index].push_back(entry);
+            return;
+        }
+    }
+
+    auto position = std::upper_bound(bottom.begin(), bottom.end(), entry, queuedAfter);
+    bottom.insert(position, entry);
+
+    // Keep sorted insertion cheap by turning an oversized Bottom into a rung
+    long long bottomRange = bottom.front().event.getTime() - bottom.back().event.getTime() + 1;
+    if (bottom.size() > THRESHOLD && bottomRange > 1 && rungs.size() < MAX_RUNGS) {
+        long long width = std::max(1LL, bottomRange / static_cast<long long>(bottom.size()));
+        spawnRung(bottom.back().event.getTime(), width, bottomRange, bottom);
+        bottom.clear();
+    }
+}
+
+void LadderEventQueue::spawnRung(long long start, long long width, long long range,
+                                 std::vector<QueuedEvent>& entries) {
+    Rung rung;
+    rung.start = start;
+    rung.width = width;
+    rung.current = 0;
+    rung.buckets.resize(static_cast<std::size_t>((range + width - 1) / width));
+    for (const auto& entry : entries) {
+        rung.buckets[static_cast<std::size_t>((entry.event.getTime() - start) / width)].push_back(entry);
+    }
+    rungs.push_back(std::move(rung));
+}
+
+void LadderEventQueue::moveToBottom(std::vector<QueuedEvent>& entries) {
+    bottom.insert(bottom.end(), entries.begin(), entries.end());
+    std::sort(bottom.begin(), bottom.end(), queuedAfter);
+}
+
+void LadderEventQueue::dropCancelled() {
+    while (!bottom.empty() && !handles.isCurrent(bottom.back())) {
+        bottom.pop_back();
+    }
+}
+
+void LadderEventQueue::settle() {
+    // Make sure the earliest live event is at the back of Bottom
+    dropCancelled();
+    while (bottom.empty()) {
+        if (rungs.empty()) {
+            if (topEvents.empty()) {
+                topStart = LLONG_MIN;
+                return;
+            }
+
+            std::vector<QueuedEvent> entries;
+            entries.swap(topEvents);
+            if (entries.size() <= THRESHOLD) {
+                topStart = topMax + 1;
+                moveToBottom(entries);
+            } else {
+                long long width = std::max(1LL, (topMax - topMin) / static_cast<long long>(entries.size()));
+                spawnRung(topMin, width, topMax - topMin + 1, entries);
+                topStart = rungs.back().start +
+                           static_cast<long long>(rungs.back().buckets.size()) * width;
+            }
+        } else {
+            Rung& rung = rungs.back();
+            while (rung.current < rung.buckets.size() && rung.buckets[rung.current].empty()) {
+                rung.current++;
+            }
+            if (rung.current == rung.buckets.size()) {
+                rungs.pop_back();
+                continue;
+            }
+
+            std::vector<QueuedEvent> entries;
+            entries.swap(rung.buckets[rung.current]);
+            long long bucketStart = rung.currentStart();
+            long long width = rung.width;
+            rung.current++;
+
+            if (entries.size() > THRESHOLD && width > 1 && rungs.size() < MAX_RUNGS) {
+                long long childWidth = std::max(1LL, width / static_cast<long long>(entries.size()));
+                spawnRung(bucketStart, childWidth, width, entries);
+            } else {
+                moveToBottom(entries);
+            }
+        }
+        dropCancelled();
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef LADDER_QUEUE_H
+#define LADDER_QUEUE_H
+
+#include <vector>
+#include "event_queue.h"
+
+// Ladder queue (Tang, Goh and Thng, 2005): far-future events are appended
+// unsorted to Top, nearer events are spread over rungs of progressively
+// narrower buckets, and only the few events of the current bucket are
+// sorted in Bottom. Enqueue and dequeue are O(1) amortized. Cancelled events
+// are left in place as tombstones and skipped when they reach Bottom.
+class LadderEventQueue : public EventQueue {
+public:
+    LadderEventQueue();
+
+    Handle push(const Event& event) override;
+    const Event& top() const override;
+    void pop() override;
+    bool cancel(Handle handle) override;
+    bool reschedule(Handle handle, SimTime newTime) override;
+    bool contains(Handle handle) const override;
+    bool empty() const override;
+    std::size_t size() const override;
+    void clear() override;
+
+private:
+    // Buckets larger than this are split into a new rung instead of sorted
+    static const std::size_t THRESHOLD = 50;
+    static const std::size_t MAX_RUNGS = 8;
+
+    struct Rung {
+        long long start;
+        long long width;
+        std::size_t current;    // First bucket not yet handed to Bottom
+        std::vector<std::vector<QueuedEvent>> buckets;
+
+        long long currentStart() const { return start + static_cast<long long>(current) * width; }
+    };
+
+    std::vector<QueuedEvent> topEvents;
+    long long topMin;
+    long long topMax;
+    long long topStart;         // Events at or after this time go to Top
+    std::vector<Rung> rungs;
+    std::vector<QueuedEvent> bottom;    // Sorted descending, earliest last
+
+    std::size_t count;
+    EventHandleTable handles;
+    unsigned int nextSequence;
+
+    void insert(const QueuedEvent& entry);
+    void spawnRung(long long start, long long width, long long range, std::vector<QueuedEvent>& entries);
+    void moveToBottom(std::vector<QueuedEvent>& entries);
+    void dropCancelled();
+    void settle();
+};
+
+#endif // LADDER_QUEUE_H
@@ -0,0 +1,82 @@
+#include <cmath>
+#include <algorithm>
+#include "latency_histogram.h"
+
+LatencyHistogram::LatencyHistogram() : count(0), sum(0), min(0), max(0) {}
+
+void LatencyHistogram::record(long long value) {
+    value = std::max(value, 0LL);
+    std::size_t bucket = bucketOf(value);
+    if (bucket >= counts.size()) {
+        counts.resize(bucket + 1, 0);
+    }
+    counts[bucket]++;
+    min = count == 0 ? value : std::min(min, value);
+    max = count == 0 ? value : std::max(max, value);
+    count++;
+    sum += value;
+}
+
+long long LatencyHistogram::getCount() const {
+    return count;
+}
+
+double LatencyHistogram::getMean() const {
+    return count == 0 ? 0.0 : static_cast<double>(sum) / count;
+}
+
+long long LatencyHistogram::getMin() const {
+    return min;
+}
+
+long long LatencyHistogram::getMax() const {
+    return max;
+}
+
+long long LatencyHistogram::getPercentile(double percentile) const {
+    if (count == 0) {
+        return 0;
+    }
+    long long rank = static_cast<long long>(std::ceil(percentile / 100.0 * count));
+    rank = std::min(std::max(rank, 1LL), count);
+
+    long long seen = 0;
+    for (std::size_t bucket = 0; bucket < counts.size(); ++bucket) {
+        seen += counts[bucket];
+        if (seen >= rank) {
+            return std::min(highestValueIn(bucket), max);
+        }
+    }
+    return max;
+}
+
+std::size_t LatencyHistogram::bucketOf(long long value) {
+    const long long exact = 1 << EXACT_BITS;
+    if (value < exact) {
+        return static_cast<std::size_t>(value);
+    }
+
+    // Position of the highest set bit; the next SUB_BUCKET_BITS bits select
+    // the bucket within that power of two
+    int magnitude = EXACT_BITS;
+    while ((value >> (magnitude + 1)) != 0) {
+        magnitude++;
+    }
+    int shift = magnitude - SUB_BUCKET_BITS;
+    long long subBucket = (value >> shift) - (1 << SUB_BUCKET_BITS);
+    return static_cast<std::size_t>(exact + static_cast<long long>(magnitude - EXACT_BITS) * (1 << SUB_BUCKET_BITS) +
+                                    subBucket);
+}
+
+long long LatencyHistogram::highestValueIn(std::size_t bucket) {
+    const std::size_t exact = 1 << EXACT_BITS;
+    if (bucket < exact) {
+        return static_cast<long long>(bucket);
+    }
+    std::size_t offset = bucket - exact;
+    int magnitude = EXACT_BITS + static_cast<int>(offset >> SUB_BUCKET_BITS);
+    long long subBucket = (1 << SUB_BUCKET_BITS) + static_cast<long long>(offset & ((1 << SUB_BUCKET_BITS) - 1));
+    int shift = magnitude - SUB_BUCKET_BITS;
+    // Written so the top bucket of the 64-bit range does not overflow
+    return (subBucket << shift) + ((1LL << shift) - 1);
+}
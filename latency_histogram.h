@@ -0,0 +1,40 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <vector>
+#include <cstddef>
+
+// Online distribution of non-negative times with log-linear buckets: values
+// below 256 are counted exactly, larger ones in 128 buckets per power of two,
+// so a percentile is within 1% of the exact one. Memory grows with the
+// logarithm of the largest value, not with the number of samples.
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void record(long long value);
+
+    long long getCount() const;
+    double getMean() const;
+    long long getMin() const;
+    long long getMax() const;
+
+    // Nearest-rank percentile, reported as the upper end of its bucket (at
+    // most the largest value seen); 0 when empty
+    long long getPercentile(double percentile) const;
+
+private:
+    static const int EXACT_BITS = 8;    // Values below 2^EXACT_BITS have their own bucket
+    static const int SUB_BUCKET_BITS = EXACT_BITS - 1;
+
+    std::vector<long long> counts;
+    long long count;
+    long long sum;
+    long long min;
+    long long max;
+
+    static std::size_t bucketOf(long long value);
+    static long long highestValueIn(std::size_t bucket);
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -3,21 +3,226 @@
 #include <string>
 #include <vector>
 #include <sstream>
+#include <future>
+#include <random>
+#include <memory>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "simulator.h"
 #include "process.h"
+#include "input_parser.h"
+#include "process_stream.h"
+#include "workload_format.h"
 #include "generator.h"
+#include "thread_pool.h"
+#include "sweep.h"
+#include "replication.h"
+#include "trace_writer.h"
+
+// Outcome of one policy run in parallel mode
+struct PolicyRun {
+    std::string trace;
+    std::string eventLog;   // Binary records of the run
+    Statistics statistics;
+    std::string processes;  // Per-process lines of detailed mode
+};
 
 void printUsage() {
-    std::cout << "Usage: sim [-d] [-v] [-a algorithm] < input_file" << std::endl;
+    std::cout << "Usage: sim [-d] [-v] [-a algorithm] [-c cpus] [-q queue] [-j threads] [-Q range] [-O range]" << std::endl;
+    std::cout << "           [-r replications [-s seed] [-n processes]] [-m model] [-S] [-p]" << std::endl;
+    std::cout << "           [-D devices[:discipline]] [-t event_log] < input_file" << std::endl;
+    std::cout << "       sim convert input_file output_file" << std::endl;
+    std::cout << "       sim decode event_log" << std::endl;
+    std::cout << "       sim generate processes output_file [-s seed] [-j threads] [-m model] [-b]" << std::endl;
     std::cout << "  -d: Detailed information mode" << std::endl;
     std::cout << "  -v: Verbose mode" << std::endl;
-    std::cout << "  -a algorithm: Execute a specific algorithm (FCFS, SJF, SRTN, RR10, RR50, or RR100)" << std::endl;
+    std::cout << "  -a algorithm: Execute a specific algorithm (FCFS, SJF, SRTN, RR<quantum>, e.g. RR10, EDF, RM," << std::endl;
+    std::cout << "                MLFQ[<q0>/<q1>/...[:<boost>]], default MLFQ10/20/40:1000," << std::endl;
+    std::cout << "                CFS[<latency>/<granularity>], default CFS80/10," << std::endl;
+    std::cout << "                LOTTERY[<quantum>] or STRIDE[<quantum>], default quantum 10," << std::endl;
+    std::cout << "                PRIO[<aging>] or PPRIO[<aging>], default aging interval 100)" << std::endl;
+    std::cout << "  -c cpus: Number of CPUs, each with its own ready queue (default 1)" << std::endl;
+    std::cout << "  -D devices[:fcfs|:sstf]: Shared I/O devices, each serving its queue first come first served" << std::endl;
+    std::cout << "                           or shortest burst first (default: a device per I/O burst)" << std::endl;
+    std::cout << "  -q queue: Event queue implementation (heap, calendar, or ladder; default heap)" << std::endl;
+    std::cout << "  -j threads: Run the algorithms in parallel on this many threads (default 1)" << std::endl;
+    std::cout << "  -Q first:last[:step]: Sweep the Round Robin time quantum over a range" << std::endl;
+    std::cout << "  -O first:last[:step]: Sweep the process switch overhead over a range" << std::endl;
+    std::cout << "  -r replications: Simulate this many generated workloads and report 95% confidence intervals" << std::endl;
+    std::cout << "  -s seed: Base seed of the generated workloads (default 1)" << std::endl;
+    std::cout << "  -n processes: Processes per generated workload (default 50)" << std::endl;
+    std::cout << "  -m model: Workload model file with the distributions of generated workloads" << std::endl;
+    std::cout << "  -S: Streaming mode, read arrivals lazily from input sorted by arrival time" << std::endl;
+    std::cout << "  -p: Report percentiles of turnaround, waiting and response time" << std::endl;
+    std::cout << "  -t event_log: Write every state transition to a binary event log" << std::endl;
+}
+
+// Convert a text workload to the binary format or a binary one back to
+// text; "-" stands for stdin or stdout
+int convertWorkload(const std::string& inputPath, const std::string& outputPath) {
+    int fd = inputPath == "-" ? STDIN_FILENO : open(inputPath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Cannot open " << inputPath << std::endl;
+        return 1;
+    }
+    InputParser parser;
+    bool parsed = parser.parseFile(fd);
+    if (fd != STDIN_FILENO) {
+        close(fd);
+    }
+    if (!parsed) {
+        std::cerr << parser.getError() << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (outputPath != "-") {
+        file.open(outputPath.c_str(), std::ios::binary);
+        if (!file) {
+            std::cerr << "Cannot write " << outputPath << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = outputPath == "-" ? std::cout : file;
+    if (parser.isBinaryInput()) {
+        TextWorkload::write(out, parser.getWorkload(), parser.getProcessSwitchOverhead());
+    } else {
+        BinaryWorkload::write(out, parser.getWorkload(), parser.getProcessSwitchOverhead());
+    }
+    if (!out) {
+        std::cerr << "Error writing " << outputPath << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+// Print the verbose text of a binary event log; "-" stands for stdin
+int decodeEventLog(const std::string& inputPath) {
+    std::ifstream file;
+    if (inputPath != "-") {
+        file.open(inputPath.c_str(), std::ios::binary);
+        if (!file) {
+            std::cerr << "Cannot open " << inputPath << std::endl;
+            return 1;
+        }
+    }
+    std::string error;
+    if (!EventLog::decode(inputPath == "-" ? std::cin : file, std::cout, error)) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+// Write a generated workload, text or binary (-b), without holding it in
+// memory; "-" stands for stdout (text only)
+int generateWorkload(int argc, char* argv[]) {
+    std::istringstream countText(argv[2]);
+    int count;
+    if (!(countText >> count) || count < 1) {
+        std::cerr << "Invalid count: " << argv[2] << std::endl;
+        printUsage();
+        return 1;
+    }
+    std::string outputPath = argv[3];
+    unsigned long long seed = 1;
+    int threadCount = 1;
+    ProcessGenerator::Format format = ProcessGenerator::Format::TEXT;
+    WorkloadModel model;
+    for (int i = 4; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-s" && i + 1 < argc) {
+            std::istringstream iss(argv[++i]);
+            if (!(iss >> seed)) {
+                std::cerr << "Invalid seed: " << argv[i] << std::endl;
+                printUsage();
+                return 1;
+            }
+        } else if (arg == "-j" && i + 1 < argc) {
+            std::istringstream iss(argv[++i]);
+            if (!(iss >> threadCount) || threadCount < 1) {
+                std::cerr << "Invalid thread count: " << argv[i] << std::endl;
+                printUsage();
+                return 1;
+            }
+        } else if (arg == "-m" && i + 1 < argc) {
+            if (!model.load(argv[++i])) {
+                std::cerr << model.getError() << std::endl;
+                return 1;
+            }
+        } else if (arg == "-b") {
+            format = ProcessGenerator::Format::BINARY;
+        } else {
+            std::cerr << "Invalid argument: " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+    if (outputPath == "-" && format == ProcessGenerator::Format::BINARY) {
+        std::cerr << "Binary workloads are written to a file, not standard output" << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (outputPath != "-") {
+        file.open(outputPath.c_str(), std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "Cannot write " << outputPath << std::endl;
+            return 1;
+        }
+    }
+    ProcessGenerator generator(seed, model);
+    std::string error;
+    if (!generator.writeProcesses(count, 5, format, outputPath == "-" ? std::cout : file, threadCount, error)) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+    return 0;
 }
 
 int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "convert") {
+        if (argc != 4) {
+            printUsage();
+            return 1;
+        }
+        return convertWorkload(argv[2], argv[3]);
+    }
+    if (argc > 1 && std::string(argv[1]) == "decode") {
+        if (argc != 3) {
+            printUsage();
+            return 1;
+        }
+        return decodeEventLog(argv[2]);
+    }
+    if (argc > 1 && std::string(argv[1]) == "generate") {
+        if (argc < 4) {
+            printUsage();
+            return 1;
+        }
+        return generateWorkload(argc, argv);
+    }
+
     bool detailedMode = false;
     bool verboseMode = false;
     std::string algorithm = "";
+    std::string eventQueueKind = "heap";
+    int threadCount = 1;
+    int coreCount = 1;
+    int deviceCount = 0;
+    DeviceDiscipline deviceDiscipline = DeviceDiscipline::FCFS;
+    bool sweepQuantum = false;
+    bool sweepOverhead = false;
+    SweepRange quantumRange;
+    SweepRange overheadRange;
+    int replications = 0;
+    unsigned int baseSeed = 1;
+    int replicationProcesses = 50;
+    bool streamingMode = false;
+    bool percentileMode = false;
+    std::string eventLogPath;
+    WorkloadModel model;
 
     // Parse command line arguments
     for (int i = 1; i < argc; ++i) {
@@ -28,12 +233,72 @@ int main(int argc, char* argv[]) {
             verboseMode = true;
         } else if (arg == "-a" && i + 1 < argc) {
             algorithm = argv[++i];
-            if (algorithm != "FCFS" && algorithm != "SJF" && algorithm != "SRTN" && 
-                algorithm != "RR10" && algorithm != "RR50" && algorithm != "RR100") {
+            if (!isValidAlgorithm(algorithm)) {
                 std::cerr << "Invalid algorithm: " << algorithm << std::endl;
                 printUsage();
                 return 1;
             }
+        } else if (arg == "-q" && i + 1 < argc) {
+            eventQueueKind = argv[++i];
+            if (!isValidEventQueueKind(eventQueueKind)) {
+                std::cerr << "Invalid event queue: " << eventQueueKind << std::endl;
+                printUsage();
+                return 1;
+            }
+        } else if (arg == "-j" && i + 1 < argc) {
+            std::istringstream iss(argv[++i]);
+            if (!(iss >> threadCount) || threadCount < 1) {
+                std::cerr << "Invalid thread count: " << argv[i] << std::endl;
+                printUsage();
+                return 1;
+            }
+        } else if (arg == "-c" && i + 1 < argc) {
+            std::istringstream iss(argv[++i]);
+            if (!(iss >> coreCount) || coreCount < 1) {
+                std::cerr << "Invalid CPU count: " << argv[i] << std::endl;
+                printUsage();
+                return 1;
+            }
+        } else if (arg == "-D" && i + 1 < argc) {
+            if (!parseDevices(argv[++i], deviceCount, deviceDiscipline)) {
+                std::cerr << "Invalid devices: " << argv[i] << std::endl;
+                printUsage();
+                return 1;
+            }
+        } else if ((arg == "-Q" || arg == "-O") && i + 1 < argc) {
+            SweepRange& range = arg == "-Q" ? quantumRange : overheadRange;
+            if (!range.parse(argv[++i]) || range.first < (arg == "-Q" ? 1 : 0)) {
+                std::cerr << "Invalid range: " << argv[i] << std::endl;
+                printUsage();
+                return 1;
+            }
+            (arg == "-Q" ? sweepQuantum : sweepOverhead) = true;
+        } else if ((arg == "-r" || arg == "-n") && i + 1 < argc) {
+            int& value = arg == "-r" ? replications : replicationProcesses;
+            std::istringstream iss(argv[++i]);
+            if (!(iss >> value) || value < 1) {
+                std::cerr << "Invalid count: " << argv[i] << std::endl;
+                printUsage();
+                return 1;
+            }
+        } else if (arg == "-S") {
+            streamingMode = true;
+        } else if (arg == "-p") {
+            percentileMode = true;
+        } else if (arg == "-t" && i + 1 < argc) {
+            eventLogPath = argv[++i];
+        } else if (arg == "-m" && i + 1 < argc) {
+            if (!model.load(argv[++i])) {
+                std::cerr << model.getError() << std::endl;
+                return 1;
+            }
+        } else if (arg == "-s" && i + 1 < argc) {
+            std::istringstream iss(argv[++i]);
+            if (!(iss >> baseSeed)) {
+                std::cerr << "Invalid seed: " << argv[i] << std::endl;
+                printUsage();
+                return 1;
+            }
         } else {
             std::cerr << "Invalid argument: " << arg << std::endl;
             printUsage();
@@ -41,125 +306,193 @@ int main(int argc, char* argv[]) {
         }
     }
 
-    // Create a processes vector to store the parsed processes
-    std::vector<Process> processes;
-    int processSwitchOverhead = 0;
+    if (streamingMode && (detailedMode || sweepQuantum || sweepOverhead || replications > 0)) {
+        std::cerr << "Streaming mode cannot be combined with -d, -Q, -O or -r" << std::endl;
+        printUsage();
+        return 1;
+    }
 
-    // Read input from stdin
-    std::string line;
-    int lineNum = 0;
-    int numProcesses = 0;
-    int currentProcess = 0;
-    int currentBurst = 0;
-    int maxBursts = 0;
+    // Algorithms to run, in output order
+    std::vector<std::string> algorithms;
+    if (algorithm.empty()) {
+        algorithms = { "FCFS", "SJF", "SRTN", "RR10", "RR50", "RR100" };
+    } else {
+        algorithms.push_back(algorithm);
+    }
 
-    while (std::getline(std::cin, line)) {
-        if (lineNum == 0) {
-            // First line: number of processes and process switch overhead
-            std::istringstream iss(line);
-            iss >> numProcesses >> processSwitchOverhead;
-            lineNum++;
-        } else {
-            std::istringstream iss(line);
-            int value1, value2, value3;
-
-            if (iss >> value1 >> value2 >> value3) {
-                if (currentBurst == 0) {
-                    // This is a process definition line (process number, arrival time, number of bursts)
-                    currentProcess = value1;
-                    int arrivalTime = value2;
-                    maxBursts = value3;
-                    
-                    // Create a new process
-                    Process process(currentProcess, arrivalTime);
-                    processes.push_back(process);
-                    currentBurst = 1;
-                } else {
-                    // This is a burst definition line (burst number, CPU time, IO time)
-                    int burstNum = value1;
-                    int cpuTime = value2;
-                    int ioTime = value3;
-                    
-                    // Add CPU burst
-                    processes.back().addCPUBurst(cpuTime);
-                    
-                    // Add IO burst if this is not the last burst
-                    if (burstNum < maxBursts) {
-                        processes.back().addIOBurst(ioTime);
-                    }
-                    
-                    currentBurst++;
-                    if (currentBurst > maxBursts) {
-                        // Move to the next process
-                        currentBurst = 0;
-                    }
-                }
-            } else {
-                std::cerr << "Error parsing line: " << line << std::endl;
+    if (replications > 0) {
+        // Monte Carlo replication over generated workloads, no input is read
+        ReplicationEngine engine(replications, baseSeed, replicationProcesses, 5, eventQueueKind, coreCount,
+                                 threadCount);
+        engine.setWorkloadModel(model);
+        engine.setDevices(deviceCount, deviceDiscipline);
+        ReplicationEngine::output(engine.run(algorithms), replications, std::cout);
+        return 0;
+    }
+
+    // Verbose text goes to stdout, the event log to its file; transitions are
+    // only recorded when one of them is requested
+    std::ofstream eventLogFile;
+    if (!eventLogPath.empty()) {
+        eventLogFile.open(eventLogPath.c_str(), std::ios::binary);
+        if (!eventLogFile) {
+            std::cerr << "Cannot write " << eventLogPath << std::endl;
+            return 1;
+        }
+        EventLog::writeHeader(eventLogFile);
+    }
+    bool tracing = verboseMode || !eventLogPath.empty();
+    std::unique_ptr<TraceWriter> textTrace;
+    std::unique_ptr<TraceWriter> eventLog;
+    if (verboseMode) {
+        textTrace.reset(new TraceWriter(std::cout, TraceWriter::Format::TEXT));
+    }
+    if (!eventLogPath.empty()) {
+        eventLog.reset(new TraceWriter(eventLogFile, TraceWriter::Format::BINARY));
+    }
+    
+    if (streamingMode) {
+        // Each algorithm replays the input through its own stream; a pipe can
+        // only be read once
+        struct stat info;
+        bool regularFile = fstat(STDIN_FILENO, &info) == 0 && S_ISREG(info.st_mode);
+        if (algorithms.size() > 1 && !regularFile) {
+            std::cerr << "Streaming several algorithms needs a regular file as input; select one with -a" << std::endl;
+            return 1;
+        }
+        for (const auto& name : algorithms) {
+            ProcessStream stream(STDIN_FILENO);
+            if (!stream.getError().empty()) {
+                std::cerr << stream.getError() << std::endl;
+                return 1;
+            }
+            Simulator simulator(Workload(), stream.getProcessSwitchOverhead(), eventQueueKind);
+            simulator.setCoreCount(coreCount);
+            simulator.setDevices(deviceCount, deviceDiscipline);
+            simulator.setProcessStream(&stream);
+            if (textTrace) {
+                simulator.addTraceWriter(*textTrace);
+            }
+            if (eventLog) {
+                simulator.addTraceWriter(*eventLog);
+            }
+            Statistics statistics = simulator.run(name, tracing);
+            if (!stream.getError().empty()) {
+                std::cerr << stream.getError() << std::endl;
                 return 1;
             }
+            statistics.output(false, percentileMode);
         }
+        return 0;
+    }
+
+    // Parse the workload from stdin
+    InputParser parser;
+    if (!parser.parseFile(STDIN_FILENO)) {
+        std::cerr << parser.getError() << std::endl;
+        return 1;
     }
+    Workload workload;
+    std::swap(workload, parser.getWorkload());
+    int processSwitchOverhead = parser.getProcessSwitchOverhead();
 
     // If no processes were read, generate random processes
-    if (processes.empty()) {
+    if (workload.empty()) {
         std::cout << "No input provided. Generating 50 random processes..." << std::endl;
-        ProcessGenerator generator;
-        processes = generator.generateProcesses(50, 5);
+        ProcessGenerator generator(std::random_device{}(), model);
+        workload = generator.generateProcesses(50, 5);
         processSwitchOverhead = 5;
         
         // Save the generated processes to a file for reference
         std::ofstream outFile("generated_processes.txt");
-        outFile << processes.size() << " " << processSwitchOverhead << std::endl;
-        for (const auto& process : processes) {
-            outFile << process.getId() << " " << process.getArrivalTime() << " " 
-                    << process.getBursts().size() / 2 + 1 << std::endl;
-            
-            for (size_t i = 0; i < process.getBursts().size(); ++i) {
-                const Burst& burst = process.getBursts()[i];
-                if (burst.type == BurstType::CPU) {
-                    int burstNum = (i / 2) + 1;
-                    outFile << burstNum << " " << burst.duration;
-                    
-                    // If there's an IO burst after this CPU burst, add it
-                    if (i + 1 < process.getBursts().size()) {
-                        outFile << " " << process.getBursts()[i + 1].duration << std::endl;
-                    } else {
-                        outFile << std::endl;
-                    }
-                }
-            }
-        }
+        TextWorkload::write(outFile, workload, processSwitchOverhead);
         outFile.close();
         std::cout << "Random processes saved to 'generated_processes.txt'" << std::endl;
     }
 
-    // Create simulator
-    Simulator simulator(processes, processSwitchOverhead);
+    if (sweepQuantum || sweepOverhead) {
+        // Parameter sweep: Round Robin over the quantum range, or the selected
+        // algorithms when only the overhead is swept
+        std::vector<int> overheads = sweepOverhead ? overheadRange.values()
+                                                   : std::vector<int>(1, processSwitchOverhead);
+        std::vector<SweepPoint> points;
+        for (int overhead : overheads) {
+            if (sweepQuantum) {
+                for (int quantum : quantumRange.values()) {
+                    SweepPoint point = { "RR" + std::to_string(quantum), quantum, overhead };
+                    points.push_back(point);
+                }
+            } else {
+                for (const auto& name : algorithms) {
+                    int quantum = name.substr(0, 2) == "RR" ? std::stoi(name.substr(2)) : 0;
+                    SweepPoint point = { name, quantum, overhead };
+                    points.push_back(point);
+                }
+            }
+        }
 
-    // Run simulations based on algorithm flag
-    if (algorithm.empty() || algorithm == "FCFS") {
-        simulator.runFCFS(detailedMode, verboseMode);
-    }
-    
-    if (algorithm.empty() || algorithm == "SJF") {
-        simulator.runSJF(detailedMode, verboseMode);
-    }
-    
-    if (algorithm.empty() || algorithm == "SRTN") {
-        simulator.runSRTN(detailedMode, verboseMode);
-    }
-    
-    if (algorithm.empty() || algorithm == "RR10") {
-        simulator.runRR(10, detailedMode, verboseMode);
-    }
-    
-    if (algorithm.empty() || algorithm == "RR50") {
-        simulator.runRR(50, detailedMode, verboseMode);
+        SweepEngine engine(workload, eventQueueKind, coreCount, threadCount);
+        engine.setDevices(deviceCount, deviceDiscipline);
+        SweepEngine::output(engine.run(points), std::cout);
+        return 0;
     }
-    
-    if (algorithm.empty() || algorithm == "RR100") {
-        simulator.runRR(100, detailedMode, verboseMode);
+
+    if (threadCount <= 1 || algorithms.size() <= 1) {
+        // Run the algorithms one after another on a single simulator
+        Simulator simulator(workload, processSwitchOverhead, eventQueueKind);
+        simulator.setCoreCount(coreCount);
+        simulator.setDevices(deviceCount, deviceDiscipline);
+        if (textTrace) {
+            simulator.addTraceWriter(*textTrace);
+        }
+        if (eventLog) {
+            simulator.addTraceWriter(*eventLog);
+        }
+        for (const auto& name : algorithms) {
+            simulator.run(name, tracing).output(detailedMode, percentileMode);
+            if (detailedMode) {
+                Statistics::outputProcesses(simulator.getProcesses(), std::cout, isProportionalShare(name));
+            }
+        }
+    } else {
+        // Each worker simulates on its own copy of the workload and formats its
+        // traces in memory; traces and statistics are written afterwards in
+        // the sequential order
+        ThreadPool pool(threadCount);
+        std::vector<std::future<PolicyRun>> runs;
+        for (const auto& name : algorithms) {
+            runs.push_back(pool.submit([&workload, processSwitchOverhead, &eventQueueKind, coreCount, deviceCount,
+                                      deviceDiscipline, name, verboseMode, detailedMode, &eventLogPath,
+                                      tracing]() {
+                std::ostringstream trace;
+                std::ostringstream eventLog;
+                TraceWriter textTrace(trace, TraceWriter::Format::TEXT, false);
+                TraceWriter binaryTrace(eventLog, TraceWriter::Format::BINARY, false);
+                Simulator simulator(workload, processSwitchOverhead, eventQueueKind);
+                simulator.setCoreCount(coreCount);
+                simulator.setDevices(deviceCount, deviceDiscipline);
+                if (verboseMode) {
+                    simulator.addTraceWriter(textTrace);
+                }
+                if (!eventLogPath.empty()) {
+                    simulator.addTraceWriter(binaryTrace);
+                }
+                Statistics statistics = simulator.run(name, tracing);
+                std::ostringstream processes;
+                if (detailedMode) {
+                    Statistics::outputProcesses(simulator.getProcesses(), processes, isProportionalShare(name));
+                }
+                PolicyRun run = { trace.str(), eventLog.str(), statistics, processes.str() };
+                return run;
+            }));
+        }
+        for (auto& run : runs) {
+            PolicyRun result = run.get();
+            std::cout << result.trace;
+            eventLogFile << result.eventLog;
+            result.statistics.output(detailedMode, percentileMode);
+            std::cout << result.processes;
+        }
     }
 
     return 0;
@@ -1,44 +1,61 @@
 #include "process.h"
 
-Process::Process(int id, int arrivalTime)
+Process::Process(int id, SimTime arrivalTime)
     : id(id), 
       arrivalTime(arrivalTime), 
       state(ProcessState::NEW), 
       currentBurstIndex(0), 
+      firstBurst(0), 
+      burstCount(0), 
+      core(-1), 
+      index(0), 
+      device(-1), 
+      level(0), 
+      levelEpoch(0), 
+      weight(DEFAULT_WEIGHT), 
+      virtualRuntime(0), 
+      chargedServiceTime(0), 
+      fairShare(0.0), 
+      priority(0), 
+      longestWait(0), 
+      deadline(0), 
+      period(0), 
+      absoluteDeadline(NO_DEADLINE), 
       totalServiceTime(0), 
       totalIOTime(0), 
       finishTime(-1), 
       startTime(-1), 
       lastStateChangeTime(arrivalTime) {}
 
-void Process::addCPUBurst(int duration) {
-    bursts.emplace_back(BurstType::CPU, duration);
-}
-
-void Process::addIOBurst(int duration) {
-    bursts.emplace_back(BurstType::IO, duration);
+void Process::setBursts(int firstBurst, int burstCount) {
+    this->firstBurst = firstBurst;
+    this->burstCount = burstCount;
 }
 
 void Process::reset() {
     state = ProcessState::NEW;
     currentBurstIndex = 0;
+    core = -1;
+    device = -1;
+    level = 0;
+    levelEpoch = 0;
+    virtualRuntime = 0;
+    chargedServiceTime = 0;
+    fairShare = 0.0;
+    longestWait = 0;
+    absoluteDeadline = NO_DEADLINE;
     totalServiceTime = 0;
     totalIOTime = 0;
     finishTime = -1;
     startTime = -1;
     lastStateChangeTime = arrivalTime;
-    
-    // Reset all bursts
-    for (auto& burst : bursts) {
-        burst.reset();
-    }
 }
 
 int Process::getId() const {
     return id;
 }
 
-int Process::getArrivalTime() const {
+SimTime Process::getArrivalTime() const {
     return arrivalTime;
 }
 
@@ -50,49 +67,105 @@ int Process::getCurrentBurstIndex() const {
     return currentBurstIndex;
 }
 
-Burst& Process::getCurrentBurst() {
-    return bursts[currentBurstIndex];
+int Process::getFirstBurst() const {
+    return firstBurst;
 }
 
-const Burst& Process::getCurrentBurst() const {
-    return bursts[currentBurstIndex];
+int Process::getBurstCount() const {
+    return burstCount;
 }
 
 bool Process::hasNextBurst() const {
-    return currentBurstIndex + 1 < static_cast<int>(bursts.size());
+    return currentBurstIndex + 1 < burstCount;
 }
 
-const std::vector<Burst>& Process::getBursts() const {
-    return bursts;
+int Process::getCurrentBurst() const {
+    return firstBurst + currentBurstIndex;
 }
 
-int Process::getTotalServiceTime() const {
+SimTime Process::getTotalServiceTime() const {
     return totalServiceTime;
 }
 
-int Process::getTotalIOTime() const {
+SimTime Process::getTotalIOTime() const {
     return totalIOTime;
 }
 
-int Process::getFinishTime() const {
+SimTime Process::getFinishTime() const {
     return finishTime;
 }
 
-int Process::getStartTime() const {
+SimTime Process::getStartTime() const {
     return startTime;
 }
 
-int Process::getLastStateChangeTime() const {
+SimTime Process::getLastStateChangeTime() const {
     return lastStateChangeTime;
 }
 
-int Process::getTurnaroundTime() const {
+SimTime Process::getTurnaroundTime() const {
     if (finishTime == -1) {
         return -1;
     }
     return finishTime - arrivalTime;
 }
 
+int Process::getCore() const {
+    return core;
+}
+
+unsigned int Process::getIndex() const {
+    return index;
+}
+
+int Process::getDevice() const {
+    return device;
+}
+
+int Process::getLevel() const {
+    return level;
+}
+
+unsigned int Process::getLevelEpoch() const {
+    return levelEpoch;
+}
+
+int Process::getWeight() const {
+    return weight;
+}
+
+SimTime Process::getVirtualRuntime() const {
+    return virtualRuntime;
+}
+
+int Process::getPriority() const {
+    return priority;
+}
+
+SimTime Process::getLongestWait() const {
+    return longestWait;
+}
+
+int Process::getDeadline() const {
+    return deadline;
+}
+
+int Process::getPeriod() const {
+    return period;
+}
+
+int Process::getRelativeDeadline() const {
+    return deadline != 0 ? deadline : period;
+}
+
+SimTime Process::getAbsoluteDeadline() const {
+    return absoluteDeadline;
+}
+
+double Process::getFairShare() const {
+    return fairShare;
+}
+
 void Process::setState(ProcessState newState) {
     state = newState;
 }
@@ -101,40 +174,99 @@ void Process::setCurrentBurstIndex(int index) {
     currentBurstIndex = index;
 }
 
-void Process::setFinishTime(int time) {
+void Process::setFinishTime(SimTime time) {
     finishTime = time;
 }
 
-void Process::setStartTime(int time) {
+void Process::setStartTime(SimTime time) {
     if (startTime == -1) {
         startTime = time;
     }
 }
 
-void Process::setLastStateChangeTime(int time) {
+void Process::setLastStateChangeTime(SimTime time) {
     lastStateChangeTime = time;
 }
 
-void Process::updateServiceTime(int time) {
-    if (getCurrentBurst().type == BurstType::CPU) {
-        int elapsed = time - lastStateChangeTime;
-        totalServiceTime += elapsed;
-    }
+void Process::setCore(int core) {
+    this->core = core;
+}
+
+void Process::setIndex(unsigned int index) {
+    this->index = index;
+}
+
+void Process::setDevice(int device) {
+    this->device = device;
+}
+
+void Process::setLevel(int level, unsigned int epoch) {
+    this->level = level;
+    levelEpoch = epoch;
 }
 
-void Process::updateIOTime(int time) {
-    if (getCurrentBurst().type == BurstType::IO) {
-        int elapsed = time - lastStateChangeTime;
-        totalIOTime += elapsed;
+void Process::setWeight(int weight) {
+    this->weight = weight;
+}
+
+void Process::setVirtualRuntime(SimTime vruntime) {
+    virtualRuntime = vruntime;
+}
+
+void Process::setPriority(int priority) {
+    this->priority = priority;
+}
+
+void Process::recordWait(SimTime wait) {
+    if (wait > longestWait) {
+        longestWait = wait;
     }
 }
 
+void Process::setDeadline(int deadline) {
+    this->deadline = deadline;
+}
+
+void Process::setPeriod(int period) {
+    this->period = period;
+}
+
+void Process::releaseJob(SimTime time) {
+    int relative = getRelativeDeadline();
+    absoluteDeadline = relative != 0 ? time + relative : NO_DEADLINE;
+}
+
+void Process::chargeVirtualRuntime() {
+    // Scaled as a difference of totals so rounding does not accumulate
+    virtualRuntime += totalServiceTime * DEFAULT_WEIGHT / weight - chargedServiceTime * DEFAULT_WEIGHT / weight;
+    chargedServiceTime = totalServiceTime;
+}
+
+void Process::startFairShare(double clock) {
+    fairShare -= clock * weight;
+}
+
+void Process::stopFairShare(double clock) {
+    fairShare += clock * weight;
+}
+
+void Process::updateServiceTime(SimTime time) {
+    SimTime elapsed = time - lastStateChangeTime;
+    totalServiceTime += elapsed;
+}
+
+void Process::updateIOTime(SimTime time) {
+    SimTime elapsed = time - lastStateChangeTime;
+    totalIOTime += elapsed;
+}
+
 bool Process::isCompleted() const {
-    return currentBurstIndex >= static_cast<int>(bursts.size());
+    return currentBurstIndex >= burstCount;
 }
 
 void Process::moveToNextBurst() {
-    if (hasNextBurst()) {
+    // Advancing past the last burst marks the process as completed
+    if (!isCompleted()) {
         currentBurstIndex++;
     }
 }
\ No newline at end of file
@@ -1,47 +1,112 @@
 #ifndef PROCESS_H
 #define PROCESS_H
 
-#include <vector>
-#include "burst.h"
 #include "types.h"
 
+// A process refers to its bursts by position in the BurstArena of its
+// workload: bursts [firstBurst, firstBurst + burstCount) belong to it.
 class Process {
 public:
-    Process(int id, int arrivalTime);
+    // Proportional share of a process: its lottery and stride tickets and its
+    // weight under fair scheduling, 1024 (nice 0) unless the input sets it
+    static const int DEFAULT_WEIGHT = 1024;
+    static const int MAX_WEIGHT = 1000000;
     
-    // Add CPU and IO bursts
-    void addCPUBurst(int duration);
-    void addIOBurst(int duration);
+    // Priority of the priority policies, 0 (the default) is the highest
+    static const int PRIORITY_LEVELS = 64;
+    
+    // Absolute deadline of processes without a relative deadline or period
+    static const SimTime NO_DEADLINE = 0x7FFFFFFFFFFFFFFFLL;
+    
+    Process(int id, SimTime arrivalTime);
+    
+    // Place the process's bursts in its arena
+    void setBursts(int firstBurst, int burstCount);
     
     // Reset the process to its initial state for a new simulation
     void reset();
     
     // Getters
     int getId() const;
-    int getArrivalTime() const;
+    SimTime getArrivalTime() const;
     ProcessState getState() const;
     int getCurrentBurstIndex() const;
-    Burst& getCurrentBurst();
-    const Burst& getCurrentBurst() const;
+    int getFirstBurst() const;
+    int getBurstCount() const;
     bool hasNextBurst() const;
-    const std::vector<Burst>& getBursts() const;
-    int getTotalServiceTime() const;
-    int getTotalIOTime() const;
-    int getFinishTime() const;
-    int getStartTime() const;
-    int getLastStateChangeTime() const;
-    int getTurnaroundTime() const;
+    
+    // Arena index of the current burst
+    int getCurrentBurst() const;
+    SimTime getTotalServiceTime() const;
+    SimTime getTotalIOTime() const;
+    SimTime getFinishTime() const;
+    SimTime getStartTime() const;
+    SimTime getLastStateChangeTime() const;
+    SimTime getTurnaroundTime() const;
+    int getCore() const;
+    unsigned int getIndex() const;
+    int getDevice() const;
+    int getLevel() const;
+    unsigned int getLevelEpoch() const;
+    int getWeight() const;
+    SimTime getVirtualRuntime() const;
+    int getPriority() const;
+    
+    // Longest single stay in a ready queue, from queueing to dispatch
+    SimTime getLongestWait() const;
+    
+    // Real-time parameters, 0 when not given. Every CPU burst is a job
+    // released when the process becomes ready for it and due the relative
+    // deadline later; without a deadline, the period is the deadline.
+    int getDeadline() const;
+    int getPeriod() const;
+    int getRelativeDeadline() const;
+    SimTime getAbsoluteDeadline() const;
+    
+    // Service time due under an ideal proportional share of the CPUs while
+    // the process was ready or running (tracked by proportional-share runs)
+    double getFairShare() const;
     
     // Setters
     void setState(ProcessState state);
     void setCurrentBurstIndex(int index);
-    void setFinishTime(int time);
-    void setStartTime(int time);
-    void setLastStateChangeTime(int time);
+    void setFinishTime(SimTime time);
+    void setStartTime(SimTime time);
+    void setLastStateChangeTime(SimTime time);
+    void setCore(int core);
+    void setIndex(unsigned int index);
+    void setDevice(int device);
+    
+    // Priority level of multilevel policies, valid while epoch is current;
+    // priority policies keep the priority a process was dispatched at
+    void setLevel(int level, unsigned int epoch);
+    
+    // Fair scheduling: CPU share relative to DEFAULT_WEIGHT, and the CPU time
+    // received scaled by DEFAULT_WEIGHT / weight
+    void setWeight(int weight);
+    void setVirtualRuntime(SimTime vruntime);
+    void setPriority(int priority);
+    
+    // A dispatch ended a stay of the given length in a ready queue
+    void recordWait(SimTime wait);
+    
+    void setDeadline(int deadline);
+    void setPeriod(int period);
+    
+    // The job of the current CPU burst is released
+    void releaseJob(SimTime time);
+    
+    // Add the service time received since the last call to the virtual runtime
+    void chargeVirtualRuntime();
+    
+    // The process becomes runnable or stops being so; clock is the service
+    // one unit of weight has been due so far
+    void startFairShare(double clock);
+    void stopFairShare(double clock);
     
-    // Calculate statistics
-    void updateServiceTime(int time);
-    void updateIOTime(int time);
+    // Calculate statistics; called when a CPU or IO burst ends or is cut short
+    void updateServiceTime(SimTime time);
+    void updateIOTime(SimTime time);
     
     // Check if the process has completed all bursts
     bool isCompleted() const;
@@ -51,17 +116,32 @@ public:
     
 private:
     int id;
-    int arrivalTime;
+    SimTime arrivalTime;
     ProcessState state;
     int currentBurstIndex;
-    std::vector<Burst> bursts;
+    int firstBurst;
+    int burstCount;
+    int core;               // CPU the process last ran on, -1 if it has not run yet
+    unsigned int index;     // Slot in the simulator's process table, events refer to it
+    int device;             // Shared I/O device serving or queueing the current burst, -1 if none
+    int level;              // Multilevel feedback queue level, 0 is the highest
+    unsigned int levelEpoch; // Priority boosts of the ready queue when level was set
+    int weight;
+    SimTime virtualRuntime;
+    SimTime chargedServiceTime; // Service time already in virtualRuntime
+    double fairShare;
+    int priority;
+    SimTime longestWait;
+    int deadline;
+    int period;
+    SimTime absoluteDeadline;   // Of the current job
     
     // Statistics
-    int totalServiceTime;
-    int totalIOTime;
-    int finishTime;
-    int startTime;
-    int lastStateChangeTime;
+    SimTime totalServiceTime;
+    SimTime totalIOTime;
+    SimTime finishTime;
+    SimTime startTime;
+    SimTime lastStateChangeTime;
 };
 
 #endif // PROCESS_H
\ No newline at end of file
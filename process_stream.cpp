@@ -0,0 +1,288 @@
+#include <cerrno>
+#include <cstring>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "process_stream.h"
+#include "workload_format.h"
+
+// Read size for text input; grows if a single line is longer
+static const std::size_t BLOCK_SIZE = 1 << 20;
+
+// Read size of each binary column cursor
+static const std::size_t COLUMN_BLOCK_SIZE = 1 << 16;
+
+ColumnCursor::ColumnCursor() : fd(-1), offset(0), position(0), filled(0) {}
+
+void ColumnCursor::open(int fd, off_t offset) {
+    this->fd = fd;
+    this->offset = offset;
+    buffer.resize(COLUMN_BLOCK_SIZE);
+    position = 0;
+    filled = 0;
+}
+
+bool ColumnCursor::next(int bytes, unsigned long long& value) {
+    if (filled - position < static_cast<std::size_t>(bytes)) {
+        std::size_t kept = filled - position;
+        std::memmove(buffer.data(), buffer.data() + position, kept);
+        ssize_t count = pread(fd, buffer.data() + kept, buffer.size() - kept, offset);
+        if (count < 0 || kept + count < static_cast<std::size_t>(bytes)) {
+            return false;
+        }
+        offset += count;
+        position = 0;
+        filled = kept + count;
+    }
+    value = 0;
+    for (int i = bytes - 1; i >= 0; --i) {
+        value = (value << 8) | static_cast<unsigned char>(buffer[position + i]);
+    }
+    position += bytes;
+    return true;
+}
+
+ProcessStream::ProcessStream(int fd)
+    : fd(fd),
+      binary(false),
+      processSwitchOverhead(0),
+      lastArrivalTime(0),
+      parser(true),
+      buffer(BLOCK_SIZE),
+      lineStart(0),
+      filled(0),
+      endOfInput(false),
+      remainingProcesses(0),
+      remainingBursts(0),
+      arrivalBytes(8),
+      shareBytes(4),
+      priorityBytes(4),
+      deadlineBytes(4),
+      deviceBytes(1) {
+    // Regular files are read from the start and may hold a binary workload
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+        char magic[BinaryWorkload::MAGIC_SIZE];
+        if (pread(fd, magic, sizeof(magic), 0) == static_cast<ssize_t>(sizeof(magic)) &&
+            BinaryWorkload::matches(magic, sizeof(magic))) {
+            binary = true;
+            openBinary();
+            return;
+        }
+        lseek(fd, 0, SEEK_SET);
+    }
+
+    // Text: the header line carries the process switch overhead
+    const char* begin;
+    const char* end;
+    if (nextLine(begin, end)) {
+        parser.parseLine(begin, end);
+        processSwitchOverhead = parser.getProcessSwitchOverhead();
+    } else if (error.empty()) {
+        error = "No input provided";
+    }
+    if (filled >= BinaryWorkload::MAGIC_SIZE && BinaryWorkload::matches(buffer.data(), filled)) {
+        error = "Streaming a binary workload needs a regular file";
+    }
+}
+
+bool ProcessStream::next(Process& process, BurstArena& bursts) {
+    if (!error.empty()) {
+        return false;
+    }
+    if (!(binary ? nextBinary(process, bursts) : nextText(process, bursts))) {
+        return false;
+    }
+    if (process.getArrivalTime() < lastArrivalTime) {
+        error = "Streaming input must be sorted by arrival time: process " +
+                std::to_string(process.getId()) + " arrives at " + std::to_string(process.getArrivalTime()) +
+                ", after a process arriving at " + std::to_string(lastArrivalTime);
+        return false;
+    }
+    lastArrivalTime = process.getArrivalTime();
+    return true;
+}
+
+int ProcessStream::getProcessSwitchOverhead() const {
+    return processSwitchOverhead;
+}
+
+const std::string& ProcessStream::getError() const {
+    return error;
+}
+
+bool ProcessStream::openBinary() {
+    char data[BinaryWorkload::HEADER_SIZE];
+    struct stat info;
+    fstat(fd, &info);
+    ssize_t count = pread(fd, data, sizeof(data), 0);
+    BinaryWorkloadHeader header;
+    if (count < 0 || !BinaryWorkload::decodeHeader(data, info.st_size, header, error)) {
+        if (error.empty()) {
+            error = std::string("Error reading input: ") + std::strerror(errno);
+        }
+        return false;
+    }
+
+    processSwitchOverhead = header.processSwitchOverhead;
+    remainingProcesses = header.processCount;
+    remainingBursts = header.burstCount;
+    arrivalBytes = header.arrivalBytes;
+    shareBytes = header.shareBytes;
+    priorityBytes = header.priorityBytes;
+    deadlineBytes = header.deadlineBytes;
+    deviceBytes = header.deviceBytes;
+    off_t offset = BinaryWorkload::HEADER_SIZE;
+    ids.open(fd, offset);
+    offset += header.processCount * 4;
+    arrivals.open(fd, offset);
+    offset += header.processCount * header.arrivalBytes;
+    burstCounts.open(fd, offset);
+    offset += header.processCount * 4;
+    shares.open(fd, offset);
+    offset += header.processCount * header.shareBytes;
+    priorities.open(fd, offset);
+    offset += header.processCount * header.priorityBytes;
+    deadlines.open(fd, offset);
+    offset += header.processCount * header.deadlineBytes;
+    periods.open(fd, offset);
+    offset += header.processCount * header.deadlineBytes;
+    durations.open(fd, offset);
+    offset += header.burstCount * 4;
+    types.open(fd, offset);
+    offset += header.burstCount;
+    devices.open(fd, offset);
+    return true;
+}
+
+bool ProcessStream::nextText(Process& process, BurstArena& bursts) {
+    Workload& pending = parser.getWorkload();
+    while (!parser.isProcessComplete()) {
+        const char* begin;
+        const char* end;
+        if (!nextLine(begin, end)) {
+            // A process cut short by the end of input is kept as read
+            if (!error.empty() || pending.empty()) {
+                return false;
+            }
+            break;
+        }
+        if (!parser.parseLine(begin, end)) {
+            error = parser.getError();
+            return false;
+        }
+    }
+    process = pending.getProcesses().back();
+    int first = bursts.append(pending.getBursts(), process.getFirstBurst(), process.getBurstCount());
+    process.setBursts(first, process.getBurstCount());
+    pending.clear();
+    return true;
+}
+
+bool ProcessStream::nextBinary(Process& process, BurstArena& bursts) {
+    if (remainingProcesses == 0) {
+        return false;
+    }
+    unsigned long long id, arrivalTime, count;
+    if (!ids.next(4, id) || !arrivals.next(arrivalBytes, arrivalTime) || !burstCounts.next(4, count)) {
+        error = "Error reading binary workload";
+        return false;
+    }
+    if (count > 0x7FFFFFFF || count > remainingBursts) {
+        error = "Invalid binary workload: burst counts exceed the burst column";
+        return false;
+    }
+    unsigned long long weight = Process::DEFAULT_WEIGHT;
+    if (shareBytes != 0 && !shares.next(shareBytes, weight)) {
+        error = "Error reading binary workload";
+        return false;
+    }
+    if (weight < 1 || weight > static_cast<unsigned long long>(Process::MAX_WEIGHT)) {
+        error = "Invalid binary workload: share out of range";
+        return false;
+    }
+    unsigned long long priority = 0;
+    if (priorityBytes != 0 && !priorities.next(priorityBytes, priority)) {
+        error = "Error reading binary workload";
+        return false;
+    }
+    if (priority >= static_cast<unsigned long long>(Process::PRIORITY_LEVELS)) {
+        error = "Invalid binary workload: priority out of range";
+        return false;
+    }
+    unsigned long long deadline = 0;
+    unsigned long long period = 0;
+    if (deadlineBytes != 0 && (!deadlines.next(deadlineBytes, deadline) || !periods.next(deadlineBytes, period))) {
+        error = "Error reading binary workload";
+        return false;
+    }
+    if (deadline > 0x7FFFFFFF || period > 0x7FFFFFFF) {
+        error = "Invalid binary workload: negative deadline or period";
+        return false;
+    }
+    remainingProcesses--;
+    remainingBursts -= count;
+
+    // Version 1 arrival times are int32, sign-extended here
+    SimTime arrival = arrivalBytes == 4 ? static_cast<int>(static_cast<unsigned int>(arrivalTime))
+                                        : static_cast<SimTime>(arrivalTime);
+    process = Process(static_cast<int>(id), arrival);
+    process.setWeight(static_cast<int>(weight));
+    process.setPriority(static_cast<int>(priority));
+    process.setDeadline(static_cast<int>(deadline));
+    process.setPeriod(static_cast<int>(period));
+    process.setBursts(static_cast<int>(bursts.size()), static_cast<int>(count));
+    for (unsigned long long b = 0; b < count; ++b) {
+        unsigned long long duration, type;
+        unsigned long long device = BurstArena::ANY_DEVICE;
+        if (!durations.next(4, duration) || !types.next(1, type) ||
+            (deviceBytes != 0 && !devices.next(deviceBytes, device))) {
+            error = "Error reading binary workload";
+            return false;
+        }
+        bursts.add(type == 0 ? BurstType::CPU : BurstType::IO, static_cast<int>(duration), static_cast<int>(device));
+    }
+    return true;
+}
+
+bool ProcessStream::nextLine(const char*& begin, const char*& end) {
+    while (true) {
+        const char* start = buffer.data() + lineStart;
+        const char* limit = buffer.data() + filled;
+        const char* newline = static_cast<const char*>(std::memchr(start, '\n', limit - start));
+        if (newline != nullptr) {
+            begin = start;
+            end = newline;
+            lineStart = newline + 1 - buffer.data();
+            return true;
+        }
+        if (endOfInput) {
+            // A last line without a newline
+            if (start == limit) {
+                return false;
+            }
+            begin = start;
+            end = limit;
+            lineStart = filled;
+            return true;
+        }
+
+        // Move the partial line to the front and read more behind it
+        std::size_t kept = filled - lineStart;
+        std::memmove(buffer.data(), start, kept);
+        lineStart = 0;
+        filled = kept;
+        if (filled == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        ssize_t count = read(fd, buffer.data() + filled, buffer.size() - filled);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            error = std::string("Error reading input: ") + std::strerror(errno);
+            return false;
+        }
+        filled += count;
+        endOfInput = count == 0;
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef PROCESS_STREAM_H
+#define PROCESS_STREAM_H
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <sys/types.h>
+#include "process.h"
+#include "burst_arena.h"
+#include "input_parser.h"
+
+// Sequential reader over one column of a binary workload file
+class ColumnCursor {
+public:
+    ColumnCursor();
+
+    void open(int fd, off_t offset);
+
+    // Read the next little-endian value of the given width
+    bool next(int bytes, unsigned long long& value);
+
+private:
+    int fd;
+    off_t offset;               // File offset of the first unbuffered byte
+    std::vector<char> buffer;
+    std::size_t position;
+    std::size_t filled;
+};
+
+// Pulls processes one at a time, in arrival order, from a text or binary
+// workload so a run only holds the processes currently in the system. Text
+// is read in fixed-size blocks from any descriptor; binary workloads must be
+// regular files, whose columns are read through separate cursors. Regular
+// files are read from the start, so one descriptor can back several streams.
+class ProcessStream {
+public:
+    explicit ProcessStream(int fd);
+
+    // Next process of the workload, with its bursts appended to the given
+    // arena; false at the end of the input or on an error (getError is then
+    // non-empty)
+    bool next(Process& process, BurstArena& bursts);
+
+    int getProcessSwitchOverhead() const;
+    const std::string& getError() const;
+
+private:
+    int fd;
+    bool binary;
+    std::string error;
+    int processSwitchOverhead;
+    SimTime lastArrivalTime;
+
+    // Text input
+    InputParser parser;
+    std::vector<char> buffer;
+    std::size_t lineStart;      // Start of the unread part of buffer
+    std::size_t filled;
+    bool endOfInput;
+
+    // Binary input
+    unsigned long long remainingProcesses;
+    unsigned long long remainingBursts;
+    int arrivalBytes;
+    int shareBytes;
+    int priorityBytes;
+    int deadlineBytes;
+    int deviceBytes;
+    ColumnCursor ids;
+    ColumnCursor arrivals;
+    ColumnCursor burstCounts;
+    ColumnCursor shares;
+    ColumnCursor priorities;
+    ColumnCursor deadlines;
+    ColumnCursor periods;
+    ColumnCursor durations;
+    ColumnCursor types;
+    ColumnCursor devices;
+
+    bool openBinary();
+    bool nextText(Process& process, BurstArena& bursts);
+    bool nextBinary(Process& process, BurstArena& bursts);
+    bool nextLine(const char*& begin, const char*& end);
+};
+
+#endif // PROCESS_STREAM_H
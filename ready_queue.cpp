@@ -0,0 +1,168 @@
+#include <algorithm>
+#include "ready_queue.h"
+
+FifoReadyQueue::FifoReadyQueue() : buffer(16), head(0), count(0) {}
+
+void FifoReadyQueue::push(Process* process) {
+    if (count == buffer.size()) {
+        // Unroll the ring into a buffer twice the size
+        std::vector<Process*> grown(buffer.size() * 2);
+        for (std::size_t i = 0; i < count; ++i) {
+            grown[i] = buffer[(head + i) & (buffer.size() - 1)];
+        }
+        buffer.swap(grown);
+        head = 0;
+    }
+    buffer[(head + count) & (buffer.size() - 1)] = process;
+    count++;
+}
+
+void FifoReadyQueue::clear() {
+    head = 0;
+    count = 0;
+}
+
+const int MultilevelReadyQueue::MAX_LEVELS;
+
+MultilevelReadyQueue::MultilevelReadyQueue(int levelCount)
+    : levels(std::max(1, std::min(levelCount, MAX_LEVELS))), nonEmpty(0), count(0), epoch(0) {}
+
+void MultilevelReadyQueue::clear() {
+    for (auto& level : levels) {
+        level.clear();
+    }
+    nonEmpty = 0;
+    count = 0;
+    epoch = 0;
+}
+
+void MultilevelReadyQueue::boost(SimTime) {
+    // Queued processes move up in level order, keeping their order within a
+    // level; the others find their level reset by the new epoch
+    epoch++;
+    for (std::size_t l = 1; l < levels.size(); ++l) {
+        while (!levels[l].empty()) {
+            Process* process = levels[l].pop();
+            process->setLevel(0, epoch);
+            levels[0].push(process);
+        }
+    }
+    nonEmpty = count == 0 ? 0 : 1u;
+}
+
+PriorityReadyQueue::PriorityReadyQueue(int agingInterval)
+    : buckets(Process::PRIORITY_LEVELS), nonEmpty(0), count(0), agingInterval(agingInterval), clock(0) {}
+
+void PriorityReadyQueue::clear() {
+    for (auto& bucket : buckets) {
+        bucket.clear();
+    }
+    nonEmpty = 0;
+    count = 0;
+    clock = 0;
+}
+
+FairReadyQueue::FairReadyQueue(int targetLatency, int minimumGranularity)
+    : heap(VirtualRuntimeKey()),
+      targetLatency(targetLatency),
+      minimumGranularity(minimumGranularity),
+      queuedWeight(0),
+      minimumVirtualRuntime(0) {}
+
+void FairReadyQueue::clear() {
+    heap.clear();
+    queuedWeight = 0;
+    minimumVirtualRuntime = 0;
+}
+
+const std::size_t LotteryReadyQueue::NO_WINNER;
+
+LotteryReadyQueue::LotteryReadyQueue()
+    : slots(16, nullptr), tickets(17, 0), used(0), count(0), totalTickets(0), winner(NO_WINNER) {}
+
+void LotteryReadyQueue::push(Process* process) {
+    std::size_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        if (used == slots.size()) {
+            // Twice the slots; the tree is rebuilt in O(n) from the counts
+            slots.resize(slots.size() * 2, nullptr);
+            tickets.assign(slots.size() + 1, 0);
+            for (std::size_t i = 1; i <= slots.size(); ++i) {
+                tickets[i] += slots[i - 1] != nullptr ? slots[i - 1]->getWeight() : 0;
+                std::size_t parent = i + (i & (0 - i));
+                if (parent <= slots.size()) {
+                    tickets[parent] += tickets[i];
+                }
+            }
+        }
+        slot = used++;
+    }
+    slots[slot] = process;
+    addTickets(slot, process->getWeight());
+    totalTickets += process->getWeight();
+    count++;
+}
+
+Process* LotteryReadyQueue::top() const {
+    if (count == 0) {
+        return nullptr;
+    }
+    if (winner == NO_WINNER) {
+        winner = findTicket(static_cast<long long>(random() % static_cast<unsigned long long>(totalTickets)));
+    }
+    return slots[winner];
+}
+
+Process* LotteryReadyQueue::pop() {
+    Process* process = top();
+    if (process == nullptr) {
+        return nullptr;
+    }
+    addTickets(winner, -process->getWeight());
+    totalTickets -= process->getWeight();
+    slots[winner] = nullptr;
+    freeSlots.push_back(winner);
+    winner = NO_WINNER;
+    count--;
+    return process;
+}
+
+void LotteryReadyQueue::clear() {
+    std::fill(slots.begin(), slots.end(), nullptr);
+    std::fill(tickets.begin(), tickets.end(), 0);
+    freeSlots.clear();
+    used = 0;
+    count = 0;
+    totalTickets = 0;
+    random.seed(std::mt19937_64::default_seed);
+    winner = NO_WINNER;
+}
+
+void LotteryReadyQueue::addTickets(std::size_t slot, long long delta) {
+    for (std::size_t i = slot + 1; i <= slots.size(); i += i & (0 - i)) {
+        tickets[i] += delta;
+    }
+}
+
+std::size_t LotteryReadyQueue::findTicket(long long ticket) const {
+    // Descend from the largest power of two, skipping subtrees whose tickets
+    // all come before the one sought
+    std::size_t position = 0;
+    for (std::size_t step = slots.size(); step > 0; step >>= 1) {
+        if (position + step <= slots.size() && tickets[position + step] <= ticket) {
+            position += step;
+            ticket -= tickets[position];
+        }
+    }
+    return position;
+}
+
+StrideReadyQueue::StrideReadyQueue() : heap(VirtualRuntimeKey()), globalPass(0) {}
+
+void StrideReadyQueue::clear() {
+    heap.clear();
+    globalPass = 0;
+}
@@ -0,0 +1,546 @@
+#ifndef READY_QUEUE_H
+#define READY_QUEUE_H
+
+#include <vector>
+#include <cstddef>
+#include <functional>
+#include <algorithm>
+#include <random>
+#include "process.h"
+#include "burst_arena.h"
+
+// Set of ready processes in the order a scheduling policy dispatches them.
+// Processes with equal keys leave in the order they entered.
+class ReadyQueue {
+public:
+    virtual ~ReadyQueue() {}
+
+    virtual void push(Process* process) = 0;
+
+    // Next process to dispatch, without removing it
+    virtual Process* top() const = 0;
+    virtual Process* pop() = 0;
+
+    virtual bool empty() const = 0;
+    virtual std::size_t size() const = 0;
+    virtual void clear() = 0;
+
+    // Queue a process whose time slice expired; policies with priority
+    // levels demote it, the others queue it like any other
+    virtual void requeue(Process* process) {
+        push(process);
+    }
+
+    // Periodic priority boost at the given time: every process, ready or
+    // not, returns to the highest level, or waiting processes age. Nothing
+    // to do for policies without priorities.
+    virtual void boost(SimTime) {}
+};
+
+// First in, first out over a growable ring buffer; O(1) push and pop. The
+// queue classes are final, so calls through the concrete type are direct and
+// the per-event operations below can be inlined.
+class FifoReadyQueue final : public ReadyQueue {
+public:
+    FifoReadyQueue();
+
+    void push(Process* process) override;
+
+    Process* top() const override {
+        return count == 0 ? nullptr : buffer[head];
+    }
+
+    Process* pop() override {
+        if (count == 0) {
+            return nullptr;
+        }
+        Process* process = buffer[head];
+        head = (head + 1) & (buffer.size() - 1);
+        count--;
+        return process;
+    }
+
+    bool empty() const override {
+        return count == 0;
+    }
+
+    std::size_t size() const override {
+        return count;
+    }
+
+    void clear() override;
+
+private:
+    std::vector<Process*> buffer;   // Capacity is always a power of two
+    std::size_t head;
+    std::size_t count;
+};
+
+// Multilevel feedback queue: one FIFO per level, level 0 first. A bitmap of
+// the non-empty levels finds the highest one with a single bit scan, so push
+// and pop are O(1) whatever the number of levels. A process keeps its level
+// between dispatches; a boost bumps the epoch, which resets the level of
+// every process, queued or not, the next time it is seen.
+class MultilevelReadyQueue final : public ReadyQueue {
+public:
+    // At most MAX_LEVELS, one bit each
+    static const int MAX_LEVELS = 32;
+
+    explicit MultilevelReadyQueue(int levelCount);
+
+    void push(Process* process) override {
+        int level = levelOf(process);
+        levels[level].push(process);
+        nonEmpty |= 1u << level;
+        count++;
+    }
+
+    Process* top() const override {
+        return count == 0 ? nullptr : levels[__builtin_ctz(nonEmpty)].top();
+    }
+
+    Process* pop() override {
+        if (count == 0) {
+            return nullptr;
+        }
+        int level = __builtin_ctz(nonEmpty);
+        Process* process = levels[level].pop();
+        if (levels[level].empty()) {
+            nonEmpty &= ~(1u << level);
+        }
+        count--;
+        // Dispatched at this level, the time slice follows from it
+        process->setLevel(level, epoch);
+        return process;
+    }
+
+    bool empty() const override {
+        return count == 0;
+    }
+
+    std::size_t size() const override {
+        return count;
+    }
+
+    void clear() override;
+
+    // Demote to the next level, the lowest one keeps its processes
+    void requeue(Process* process) override {
+        int level = std::min(levelOf(process) + 1, static_cast<int>(levels.size()) - 1);
+        process->setLevel(level, epoch);
+        push(process);
+    }
+
+    void boost(SimTime currentTime) override;
+
+private:
+    std::vector<FifoReadyQueue> levels;
+    unsigned int nonEmpty;  // Bit l set when level l holds a process
+    std::size_t count;
+    unsigned int epoch;     // Boosts so far
+
+    int levelOf(const Process* process) const {
+        return process->getLevelEpoch() == epoch ? process->getLevel() : 0;
+    }
+};
+
+// Priority scheduling with aging: one FIFO bucket per priority and a bitmap
+// of the non-empty ones. A waiting process rises one priority per aging
+// interval it has waited, as of the last aging step (a boost). Aging is
+// applied lazily, per bucket: processes of a bucket share a priority and
+// leave in the order they were queued, so the head of each bucket has waited
+// longest and is the only one that can win. A dispatch compares the aged
+// priorities of the bucket heads, the longest waiting first on a tie; no
+// waiting process is touched when time passes. The dispatched process keeps
+// its aged priority, as its level, while it runs.
+class PriorityReadyQueue final : public ReadyQueue {
+public:
+    // An aging interval of 0 turns aging off
+    explicit PriorityReadyQueue(int agingInterval);
+
+    void push(Process* process) override {
+        int priority = process->getPriority();
+        buckets[priority].push(process);
+        nonEmpty |= 1ull << priority;
+        count++;
+    }
+
+    Process* top() const override {
+        return count == 0 ? nullptr : buckets[selectBucket()].top();
+    }
+
+    Process* pop() override {
+        if (count == 0) {
+            return nullptr;
+        }
+        int priority = selectBucket();
+        Process* process = buckets[priority].pop();
+        if (buckets[priority].empty()) {
+            nonEmpty &= ~(1ull << priority);
+        }
+        count--;
+        // Runs at its aged priority until it leaves the CPU
+        process->setLevel(agedPriority(process), 0);
+        return process;
+    }
+
+    bool empty() const override {
+        return count == 0;
+    }
+
+    std::size_t size() const override {
+        return count;
+    }
+
+    void clear() override;
+
+    // Aging step: waiting times are measured up to the current time
+    void boost(SimTime currentTime) override {
+        clock = currentTime;
+    }
+
+    // Priority of a queued process after aging; a ready process last changed
+    // state when it was queued
+    int agedPriority(const Process* process) const {
+        SimTime waited = clock - process->getLastStateChangeTime();
+        if (agingInterval == 0 || waited < agingInterval) {
+            return process->getPriority();
+        }
+        SimTime steps = waited / agingInterval;
+        return steps >= process->getPriority() ? 0 : process->getPriority() - static_cast<int>(steps);
+    }
+
+    // Priority preemption: the best waiting process, aged, is strictly more
+    // urgent than the running one was when dispatched
+    bool preempts(const Process* running) const {
+        return agedPriority(top()) < running->getLevel();
+    }
+
+private:
+    std::vector<FifoReadyQueue> buckets;
+    unsigned long long nonEmpty;    // Bit p set when bucket p holds a process
+    std::size_t count;
+    int agingInterval;
+    SimTime clock;                  // Time of the last aging step
+
+    // Bucket whose head runs next; the queue must not be empty
+    int selectBucket() const {
+        unsigned long long remaining = nonEmpty;
+        int best = __builtin_ctzll(remaining);
+        if (agingInterval == 0) {
+            return best;
+        }
+        int bestPriority = agedPriority(buckets[best].top());
+        remaining &= remaining - 1;
+        while (remaining != 0) {
+            int bucket = __builtin_ctzll(remaining);
+            remaining &= remaining - 1;
+            const Process* head = buckets[bucket].top();
+            int priority = agedPriority(head);
+            if (priority < bestPriority ||
+                (priority == bestPriority &&
+                 head->getLastStateChangeTime() < buckets[best].top()->getLastStateChangeTime())) {
+                best = bucket;
+                bestPriority = priority;
+            }
+        }
+        return best;
+    }
+};
+
+// Binary min-heap on a key taken when the process is queued; O(log n) push
+// and pop. The key must not change while the process waits, which holds for
+// arrival time, burst duration and the remaining time of a preempted burst.
+template <typename Key>
+class KeyedReadyQueue final : public ReadyQueue {
+public:
+    explicit KeyedReadyQueue(Key key);
+
+    void push(Process* process) override;
+    Process* top() const override;
+    Process* pop() override;
+    bool empty() const override;
+    std::size_t size() const override;
+    void clear() override;
+
+private:
+    struct Entry {
+        long long key;
+        unsigned long sequence;
+        Process* process;
+    };
+
+    Key key;
+    std::vector<Entry> heap;
+    unsigned long nextSequence;
+
+    static bool before(const Entry& a, const Entry& b);
+};
+
+// Keys for the keyed ready queue; burst keys read the current burst of a
+// process from the arena holding it
+struct ArrivalTimeKey {
+    SimTime operator()(const Process* process) const {
+        return process->getArrivalTime();
+    }
+};
+
+struct BurstDurationKey {
+    const BurstArena* bursts;
+
+    explicit BurstDurationKey(const BurstArena& bursts) : bursts(&bursts) {}
+
+    int operator()(const Process* process) const {
+        return bursts->getDuration(process->getCurrentBurst());
+    }
+};
+
+struct RemainingTimeKey {
+    const BurstArena* bursts;
+
+    explicit RemainingTimeKey(const BurstArena& bursts) : bursts(&bursts) {}
+
+    int operator()(const Process* process) const {
+        return bursts->getRemainingTime(process->getCurrentBurst());
+    }
+};
+
+struct VirtualRuntimeKey {
+    SimTime operator()(const Process* process) const {
+        return process->getVirtualRuntime();
+    }
+};
+
+// Earliest deadline first: the absolute deadline of the current job
+struct AbsoluteDeadlineKey {
+    SimTime operator()(const Process* process) const {
+        return process->getAbsoluteDeadline();
+    }
+};
+
+// Rate monotonic: the period, or the relative deadline of processes without
+// one (deadline monotonic); processes with neither come last
+struct RateKey {
+    SimTime operator()(const Process* process) const {
+        int rate = process->getRelativeDeadline();
+        if (process->getPeriod() != 0) {
+            rate = process->getPeriod();
+        }
+        return rate != 0 ? rate : Process::NO_DEADLINE;
+    }
+};
+
+// Any of the keys behind one type, for queues whose order is chosen at run time
+typedef std::function<long long(const Process*)> KeyFunction;
+
+// Completely fair scheduling: the process with the least virtual runtime
+// runs next, taken from the heap in O(log n). Virtual runtime is charged as
+// processes are queued; a process waking up (or arriving) is placed no
+// further back than half the target latency behind the queue's minimum, so
+// sleeping earns a bounded credit. Time slices share the target latency out
+// by weight among the running process and the queued ones.
+class FairReadyQueue final : public ReadyQueue {
+public:
+    FairReadyQueue(int targetLatency, int minimumGranularity);
+
+    void push(Process* process) override {
+        process->chargeVirtualRuntime();
+        SimTime earliest = minimumVirtualRuntime - targetLatency / 2;
+        if (process->getVirtualRuntime() < earliest) {
+            process->setVirtualRuntime(earliest);
+        }
+        queuedWeight += process->getWeight();
+        heap.push(process);
+    }
+
+    Process* top() const override {
+        return heap.top();
+    }
+
+    Process* pop() override {
+        Process* process = heap.pop();
+        if (process != nullptr) {
+            queuedWeight -= process->getWeight();
+            minimumVirtualRuntime = std::max(minimumVirtualRuntime, process->getVirtualRuntime());
+        }
+        return process;
+    }
+
+    bool empty() const override {
+        return heap.empty();
+    }
+
+    std::size_t size() const override {
+        return heap.size();
+    }
+
+    void clear() override;
+
+    // Time slice of a process just taken from the queue
+    int timeSlice(const Process* process) const {
+        long long share = static_cast<long long>(targetLatency) * process->getWeight() /
+                          (queuedWeight + process->getWeight());
+        return std::max(minimumGranularity, static_cast<int>(share));
+    }
+
+    // Wake-up preemption: the leftmost process is more than the minimum
+    // granularity of virtual runtime behind the running one, which has run
+    // elapsedTime since it was dispatched
+    bool preempts(const Process* running, int elapsedTime) const {
+        SimTime runningVirtualRuntime = running->getVirtualRuntime() +
+                                        static_cast<SimTime>(elapsedTime) * Process::DEFAULT_WEIGHT /
+                                        running->getWeight();
+        return heap.top()->getVirtualRuntime() + minimumGranularity < runningVirtualRuntime;
+    }
+
+private:
+    KeyedReadyQueue<VirtualRuntimeKey> heap;
+    int targetLatency;
+    int minimumGranularity;
+    long long queuedWeight;
+    SimTime minimumVirtualRuntime;  // Never decreases
+};
+
+// Lottery scheduling: every queued process holds its weight in tickets and
+// the next one to run is drawn at random in proportion to them. Processes
+// sit in slots of a Fenwick tree of ticket counts, so the winning ticket is
+// found by one descent of the tree: push, draw and pop are O(log n). Draws
+// come from a fixed seed, so runs are reproducible; the winner is drawn
+// once, by top or pop, whichever comes first.
+class LotteryReadyQueue final : public ReadyQueue {
+public:
+    LotteryReadyQueue();
+
+    void push(Process* process) override;
+    Process* top() const override;
+    Process* pop() override;
+
+    bool empty() const override {
+        return count == 0;
+    }
+
+    std::size_t size() const override {
+        return count;
+    }
+
+    void clear() override;
+
+private:
+    static const std::size_t NO_WINNER = static_cast<std::size_t>(-1);
+
+    std::vector<Process*> slots;        // Capacity is always a power of two
+    std::vector<long long> tickets;     // Fenwick tree over the slots, 1-based
+    std::vector<std::size_t> freeSlots;
+    std::size_t used;                   // Slots handed out so far, free or not
+    std::size_t count;
+    long long totalTickets;
+    mutable std::mt19937_64 random;
+    mutable std::size_t winner;         // Slot drawn for the next pop
+
+    void addTickets(std::size_t slot, long long delta);
+
+    // Slot holding the given ticket, 0 <= ticket < totalTickets
+    std::size_t findTicket(long long ticket) const;
+};
+
+// Stride scheduling: the deterministic counterpart of lottery scheduling.
+// A process's pass advances by its service time scaled by the default weight
+// over its tickets (its virtual runtime) and the smallest pass runs next. A
+// process joining the queue starts no earlier than the smallest pass
+// dispatched so far, so time spent away earns no credit.
+class StrideReadyQueue final : public ReadyQueue {
+public:
+    StrideReadyQueue();
+
+    void push(Process* process) override {
+        process->chargeVirtualRuntime();
+        if (process->getVirtualRuntime() < globalPass) {
+            process->setVirtualRuntime(globalPass);
+        }
+        heap.push(process);
+    }
+
+    Process* top() const override {
+        return heap.top();
+    }
+
+    Process* pop() override {
+        Process* process = heap.pop();
+        if (process != nullptr) {
+            globalPass = std::max(globalPass, process->getVirtualRuntime());
+        }
+        return process;
+    }
+
+    bool empty() const override {
+        return heap.empty();
+    }
+
+    std::size_t size() const override {
+        return heap.size();
+    }
+
+    void clear() override;
+
+private:
+    KeyedReadyQueue<VirtualRuntimeKey> heap;
+    SimTime globalPass;
+};
+
+// Kept in the header so each key is inlined into the queue operations
+template <typename Key>
+KeyedReadyQueue<Key>::KeyedReadyQueue(Key key) : key(key), nextSequence(0) {}
+
+template <typename Key>
+void KeyedReadyQueue<Key>::push(Process* process) {
+    Entry entry = { key(process), nextSequence++, process };
+    heap.push_back(entry);
+    // std heap algorithms build a max-heap, so compare in reverse
+    std::push_heap(heap.begin(), heap.end(), [](const Entry& a, const Entry& b) {
+        return before(b, a);
+    });
+}
+
+template <typename Key>
+Process* KeyedReadyQueue<Key>::top() const {
+    return heap.empty() ? nullptr : heap.front().process;
+}
+
+template <typename Key>
+Process* KeyedReadyQueue<Key>::pop() {
+    if (heap.empty()) {
+        return nullptr;
+    }
+    Process* process = heap.front().process;
+    std::pop_heap(heap.begin(), heap.end(), [](const Entry& a, const Entry& b) {
+        return before(b, a);
+    });
+    heap.pop_back();
+    return process;
+}
+
+template <typename Key>
+bool KeyedReadyQueue<Key>::empty() const {
+    return heap.empty();
+}
+
+template <typename Key>
+std::size_t KeyedReadyQueue<Key>::size() const {
+    return heap.size();
+}
+
+template <typename Key>
+void KeyedReadyQueue<Key>::clear() {
+    heap.clear();
+    nextSequence = 0;
+}
+
+template <typename Key>
+bool KeyedReadyQueue<Key>::before(const Entry& a, const Entry& b) {
+    if (a.key != b.key) {
+        return a.key < b.key;
+    }
+    return a.sequence < b.sequence;
+}
+
+#endif // READY_QUEUE_H
@@ -0,0 +1,153 @@
+#include <cmath>
+#include <future>
+#include <iomanip>
+#include "replication.h"
+#include "generator.h"
+#include "simulator.h"
+#include "thread_pool.h"
+
+// Two-sided 95% Student t critical values for 1..30 degrees of freedom
+static const double T_CRITICAL_95[] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+};
+
+// Measurements of one algorithm on one replication; only these are kept
+// until all replications are done
+struct ReplicationResult {
+    double totalTime;
+    double cpuUtilization;
+    double meanTurnaroundTime;
+};
+
+ConfidenceInterval ConfidenceInterval::fromSamples(const std::vector<double>& samples) {
+    ConfidenceInterval interval = { 0.0, 0.0 };
+    std::size_t n = samples.size();
+    if (n == 0) {
+        return interval;
+    }
+
+    for (double sample : samples) {
+        interval.mean += sample;
+    }
+    interval.mean /= n;
+    if (n == 1) {
+        return interval;
+    }
+
+    double squares = 0.0;
+    for (double sample : samples) {
+        squares += (sample - interval.mean) * (sample - interval.mean);
+    }
+    double standardError = std::sqrt(squares / (n - 1) / n);
+
+    // Beyond the table use the first-order expansion of t around 1.96
+    std::size_t degrees = n - 1;
+    double t = degrees <= 30 ? T_CRITICAL_95[degrees - 1] : 1.96 + 2.37 / degrees;
+    interval.halfWidth = t * standardError;
+    return interval;
+}
+
+ReplicationEngine::ReplicationEngine(int replications, unsigned int baseSeed, int processCount,
+                                     int processSwitchOverhead, const std::string& eventQueueKind,
+                                     int coreCount, int threadCount)
+    : replications(replications),
+      baseSeed(baseSeed),
+      processCount(processCount),
+      processSwitchOverhead(processSwitchOverhead),
+      eventQueueKind(eventQueueKind),
+      coreCount(coreCount),
+      threadCount(threadCount),
+      deviceCount(0),
+      deviceDiscipline(DeviceDiscipline::FCFS) {}
+
+unsigned int ReplicationEngine::replicationSeed(unsigned int baseSeed, int replication) {
+    // SplitMix64 finalizer decorrelates consecutive replication numbers
+    unsigned long long z = (static_cast<unsigned long long>(baseSeed) << 32) +
+                           static_cast<unsigned long long>(replication) + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return static_cast<unsigned int>(z);
+}
+
+void ReplicationEngine::setWorkloadModel(const WorkloadModel& model) {
+    this->model = model;
+}
+
+void ReplicationEngine::setDevices(int count, DeviceDiscipline discipline) {
+    deviceCount = count;
+    deviceDiscipline = discipline;
+}
+
+std::vector<ReplicationSummary> ReplicationEngine::run(const std::vector<std::string>& algorithms) const {
+    // Each replication generates its workload and runs every algorithm on it
+    auto replicate = [this, &algorithms](int replication) {
+        ProcessGenerator generator(replicationSeed(baseSeed, replication), model);
+        Workload workload = generator.generateProcesses(processCount, processSwitchOverhead);
+        Simulator simulator(workload, processSwitchOverhead, eventQueueKind);
+        simulator.setCoreCount(coreCount);
+        simulator.setDevices(deviceCount, deviceDiscipline);
+
+        std::vector<ReplicationResult> results;
+        for (const auto& algorithm : algorithms) {
+            Statistics statistics = simulator.run(algorithm, false);
+            ReplicationResult result = { static_cast<double>(statistics.getTotalTime()),
+                                         statistics.getCpuUtilization(), statistics.getMeanTurnaroundTime() };
+            results.push_back(result);
+        }
+        return results;
+    };
+
+    std::vector<std::vector<ReplicationResult>> results;
+    if (threadCount <= 1) {
+        for (int i = 0; i < replications; ++i) {
+            results.push_back(replicate(i));
+        }
+    } else {
+        ThreadPool pool(threadCount);
+        std::vector<std::future<std::vector<ReplicationResult>>> pending;
+        for (int i = 0; i < replications; ++i) {
+            pending.push_back(pool.submit([&replicate, i]() { return replicate(i); }));
+        }
+        for (auto& future : pending) {
+            results.push_back(future.get());
+        }
+    }
+
+    std::vector<ReplicationSummary> summaries;
+    for (std::size_t a = 0; a < algorithms.size(); ++a) {
+        std::vector<double> totalTimes;
+        std::vector<double> utilizations;
+        std::vector<double> turnarounds;
+        for (const auto& replication : results) {
+            totalTimes.push_back(replication[a].totalTime);
+            utilizations.push_back(replication[a].cpuUtilization);
+            turnarounds.push_back(replication[a].meanTurnaroundTime);
+        }
+
+        ReplicationSummary summary;
+        summary.algorithm = algorithms[a];
+        summary.totalTime = ConfidenceInterval::fromSamples(totalTimes);
+        summary.cpuUtilization = ConfidenceInterval::fromSamples(utilizations);
+        summary.meanTurnaroundTime = ConfidenceInterval::fromSamples(turnarounds);
+        summaries.push_back(summary);
+    }
+    return summaries;
+}
+
+void ReplicationEngine::output(const std::vector<ReplicationSummary>& summaries, int replications,
+                               std::ostream& out) {
+    out << "Mean over " << replications << " replications with 95% confidence intervals" << std::endl;
+    for (const auto& summary : summaries) {
+        out << algorithmToString(summary.algorithm) << ": "
+            << std::fixed << std::setprecision(1)
+            << "Total Time required is " << summary.totalTime.mean
+            << " +/- " << summary.totalTime.halfWidth << " time units "
+            << "CPU Utilization is " << summary.cpuUtilization.mean * 100
+            << "% +/- " << summary.cpuUtilization.halfWidth * 100 << "% "
+            << "Mean Turnaround is " << summary.meanTurnaroundTime.mean
+            << " +/- " << summary.meanTurnaroundTime.halfWidth << " time units" << std::endl;
+    }
+}
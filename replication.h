@@ -0,0 +1,62 @@
+#ifndef REPLICATION_H
+#define REPLICATION_H
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include "types.h"
+#include "workload_model.h"
+
+// Sample mean with the half-width of its 95% confidence interval
+struct ConfidenceInterval {
+    double mean;
+    double halfWidth;
+
+    // Student t interval over independent samples
+    static ConfidenceInterval fromSamples(const std::vector<double>& samples);
+};
+
+// Per-algorithm summary over all replications
+struct ReplicationSummary {
+    std::string algorithm;
+    ConfidenceInterval totalTime;
+    ConfidenceInterval cpuUtilization;
+    ConfidenceInterval meanTurnaroundTime;
+};
+
+// Monte Carlo replication: simulates every algorithm on N independently
+// generated workloads. Replication i always uses the same seed for a given
+// base seed, so results are reproducible regardless of thread count.
+class ReplicationEngine {
+public:
+    ReplicationEngine(int replications, unsigned int baseSeed, int processCount,
+                      int processSwitchOverhead, const std::string& eventQueueKind, int coreCount,
+                      int threadCount);
+
+    // Distributions of the generated workloads (default WorkloadModel)
+    void setWorkloadModel(const WorkloadModel& model);
+
+    // Shared I/O devices of every simulation (none by default)
+    void setDevices(int count, DeviceDiscipline discipline);
+
+    std::vector<ReplicationSummary> run(const std::vector<std::string>& algorithms) const;
+
+    // Seed of the workload generated for one replication
+    static unsigned int replicationSeed(unsigned int baseSeed, int replication);
+
+    static void output(const std::vector<ReplicationSummary>& summaries, int replications, std::ostream& out);
+
+private:
+    int replications;
+    unsigned int baseSeed;
+    int processCount;
+    int processSwitchOverhead;
+    std::string eventQueueKind;
+    int coreCount;
+    int threadCount;
+    WorkloadModel model;
+    int deviceCount;
+    DeviceDiscipline deviceDiscipline;
+};
+
+#endif // REPLICATION_H
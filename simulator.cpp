@@ -1,95 +1,490 @@
-#include <iostream>
 #include <algorithm>
 #include <iomanip>
 #include "simulator.h"
 #include "statistics.h"
 
-Simulator::Simulator(std::vector<Process>& processes, int processSwitchOverhead)
-    : processes(processes), 
+// Retired bursts a streaming run keeps before it considers compacting
+static const std::size_t MIN_RECLAIMED_BURSTS = 1 << 12;
+
+// Scheduling policies the simulation loop is specialised on: the ready queue
+// type and its order, whether a ready process may preempt the running one
+// (and when it does), whether dispatches are cut into time slices and how
+// long they are, and how often priorities are boosted (0 for never). The
+// queue types are final, so the loop calls them directly.
+struct FcfsPolicy {
+    typedef KeyedReadyQueue<ArrivalTimeKey> Queue;
+    static const bool preemptive = false;
+    static const bool timeSliced = false;
+    bool preempts(const Queue&, const BurstArena&, const Process*, int) const { return false; }
+    int timeQuantum(const Queue&, const Process*) const { return 0; }
+    SimTime boostPeriod() const { return 0; }
+    Queue* createQueue(const BurstArena&) const { return new Queue(ArrivalTimeKey()); }
+};
+
+struct SjfPolicy {
+    typedef KeyedReadyQueue<BurstDurationKey> Queue;
+    static const bool preemptive = false;
+    static const bool timeSliced = false;
+    bool preempts(const Queue&, const BurstArena&, const Process*, int) const { return false; }
+    int timeQuantum(const Queue&, const Process*) const { return 0; }
+    SimTime boostPeriod() const { return 0; }
+    Queue* createQueue(const BurstArena& bursts) const { return new Queue(BurstDurationKey(bursts)); }
+};
+
+// A ready process with less remaining time than the running one preempts it
+static bool preemptsShorter(const ReadyQueue& queue, const BurstArena& bursts, const Process* running,
+                            int elapsedTime) {
+    return bursts.getRemainingTime(queue.top()->getCurrentBurst()) <
+           bursts.getRemainingTime(running->getCurrentBurst()) - elapsedTime;
+}
+
+struct SrtnPolicy {
+    typedef KeyedReadyQueue<RemainingTimeKey> Queue;
+    static const bool preemptive = true;
+    static const bool timeSliced = false;
+    bool preempts(const Queue& queue, const BurstArena& bursts, const Process* running, int elapsedTime) const {
+        return preemptsShorter(queue, bursts, running, elapsedTime);
+    }
+    int timeQuantum(const Queue&, const Process*) const { return 0; }
+    SimTime boostPeriod() const { return 0; }
+    Queue* createQueue(const BurstArena& bursts) const { return new Queue(RemainingTimeKey(bursts)); }
+};
+
+struct RoundRobinPolicy {
+    typedef FifoReadyQueue Queue;
+    static const bool preemptive = false;
+    static const bool timeSliced = true;
+    int quantum;
+    bool preempts(const Queue&, const BurstArena&, const Process*, int) const { return false; }
+    int timeQuantum(const Queue&, const Process*) const { return quantum; }
+    SimTime boostPeriod() const { return 0; }
+    Queue* createQueue(const BurstArena&) const { return new Queue(); }
+};
+
+// Slices grow level by level; a process that uses up its slice is demoted
+struct MlfqPolicy {
+    typedef MultilevelReadyQueue Queue;
+    static const bool preemptive = false;
+    static const bool timeSliced = true;
+    std::vector<int> quanta;
+    SimTime boost;
+    bool preempts(const Queue&, const BurstArena&, const Process*, int) const { return false; }
+    int timeQuantum(const Queue&, const Process* process) const { return quanta[process->getLevel()]; }
+    SimTime boostPeriod() const { return boost; }
+    Queue* createQueue(const BurstArena&) const { return new Queue(static_cast<int>(quanta.size())); }
+};
+
+// Slices and wake-up preemption come from the queue, which knows the
+// weights and virtual runtimes of the ready processes
+struct CfsPolicy {
+    typedef FairReadyQueue Queue;
+    static const bool preemptive = true;
+    static const bool timeSliced = true;
+    int targetLatency;
+    int minimumGranularity;
+    bool preempts(const Queue& queue, const BurstArena&, const Process* running, int elapsedTime) const {
+        return queue.preempts(running, elapsedTime);
+    }
+    int timeQuantum(const Queue& queue, const Process* process) const { return queue.timeSlice(process); }
+    SimTime boostPeriod() const { return 0; }
+    Queue* createQueue(const BurstArena&) const { return new Queue(targetLatency, minimumGranularity); }
+};
+
+// Proportional share over a fixed quantum: a random draw weighted by tickets
+// or, deterministically, the smallest pass
+struct LotteryPolicy {
+    typedef LotteryReadyQueue Queue;
+    static const bool preemptive = false;
+    static const bool timeSliced = true;
+    int quantum;
+    bool preempts(const Queue&, const BurstArena&, const Process*, int) const { return false; }
+    int timeQuantum(const Queue&, const Process*) const { return quantum; }
+    SimTime boostPeriod() const { return 0; }
+    Queue* createQueue(const BurstArena&) const { return new Queue(); }
+};
+
+struct StridePolicy {
+    typedef StrideReadyQueue Queue;
+    static const bool preemptive = false;
+    static const bool timeSliced = true;
+    int quantum;
+    bool preempts(const Queue&, const BurstArena&, const Process*, int) const { return false; }
+    int timeQuantum(const Queue&, const Process*) const { return quantum; }
+    SimTime boostPeriod() const { return 0; }
+    Queue* createQueue(const BurstArena&) const { return new Queue(); }
+};
+
+// Priorities with aging; the ready queue ages waiting processes at every
+// aging step and, when preemptive, lets a more urgent one take the CPU
+template <bool Preemptive>
+struct PriorityPolicy {
+    typedef PriorityReadyQueue Queue;
+    static const bool preemptive = Preemptive;
+    static const bool timeSliced = false;
+    int agingInterval;
+    bool preempts(const Queue& queue, const BurstArena&, const Process* running, int) const {
+        return queue.preempts(running);
+    }
+    int timeQuantum(const Queue&, const Process*) const { return 0; }
+    SimTime boostPeriod() const { return agingInterval; }
+    Queue* createQueue(const BurstArena&) const { return new Queue(agingInterval); }
+};
+
+// Real-time policies: the job with the earliest deadline, or the process
+// with the shortest period, runs and preempts any less urgent one
+struct EdfPolicy {
+    typedef KeyedReadyQueue<AbsoluteDeadlineKey> Queue;
+    static const bool preemptive = true;
+    static const bool timeSliced = false;
+    bool preempts(const Queue& queue, const BurstArena&, const Process* running, int) const {
+        return queue.top()->getAbsoluteDeadline() < running->getAbsoluteDeadline();
+    }
+    int timeQuantum(const Queue&, const Process*) const { return 0; }
+    SimTime boostPeriod() const { return 0; }
+    Queue* createQueue(const BurstArena&) const { return new Queue(AbsoluteDeadlineKey()); }
+};
+
+struct RateMonotonicPolicy {
+    typedef KeyedReadyQueue<RateKey> Queue;
+    static const bool preemptive = true;
+    static const bool timeSliced = false;
+    bool preempts(const Queue& queue, const BurstArena&, const Process* running, int) const {
+        return RateKey()(queue.top()) < RateKey()(running);
+    }
+    int timeQuantum(const Queue&, const Process*) const { return 0; }
+    SimTime boostPeriod() const { return 0; }
+    Queue* createQueue(const BurstArena&) const { return new Queue(RateKey()); }
+};
+
+// Any policy decided at run time, behind the ready queue interface and a
+// key function; the reference the specialised loops are measured against
+struct GenericPolicy {
+    typedef ReadyQueue Queue;
+    bool preemptive;
+    bool timeSliced;
+    bool fair;                  // Queues are FairReadyQueues
+    bool prioritized;           // Queues are PriorityReadyQueues
+    KeyFunction urgency;        // Real-time policies: a ready process preempts with a smaller one
+    std::vector<int> quanta;    // Per level; one for Round Robin, whose processes stay at level 0
+    SimTime boost;
+    std::function<ReadyQueue*(const BurstArena&)> create;
+    bool preempts(const Queue& queue, const BurstArena& bursts, const Process* running, int elapsedTime) const {
+        if (fair) {
+            return static_cast<const FairReadyQueue&>(queue).preempts(running, elapsedTime);
+        }
+        if (prioritized) {
+            return static_cast<const PriorityReadyQueue&>(queue).preempts(running);
+        }
+        if (urgency) {
+            return urgency(queue.top()) < urgency(running);
+        }
+        return preemptsShorter(queue, bursts, running, elapsedTime);
+    }
+    int timeQuantum(const Queue& queue, const Process* process) const {
+        return fair ? static_cast<const FairReadyQueue&>(queue).timeSlice(process) : quanta[process->getLevel()];
+    }
+    SimTime boostPeriod() const { return boost; }
+    Queue* createQueue(const BurstArena& bursts) const { return create(bursts); }
+};
+
+Simulator::Simulator(const Workload& workload, int processSwitchOverhead,
+                     const std::string& eventQueueKind)
+    : workload(workload), 
       processSwitchOverhead(processSwitchOverhead),
-      runningProcess(nullptr),
-      lastReadyQueueIndex(0),
-      nextProcessTime(0),
-      cpuBusyTime(0) {}
+      eventQueue(createEventQueue(eventQueueKind)),
+      coreCount(1),
+      deviceCount(0),
+      deviceDiscipline(DeviceDiscipline::FCFS),
+      stream(nullptr),
+      retiredBursts(0),
+      trackingFairShare(false),
+      fairShareClock(0.0),
+      fairShareTime(0),
+      runnableWeight(0),
+      runnableCount(0) {}
 
-void Simulator::runFCFS(bool detailedMode, bool verboseMode) {
+Statistics Simulator::runFCFS(bool verboseMode) {
     resetSimulation();
-    runSimulation(
-        "FCFS", 
-        [this](int currentTime) { return selectFirstComeFirstServe(currentTime); },
-        false, // non-preemptive
-        0,     // no time quantum
-        detailedMode,
-        verboseMode
-    );
+    return runSimulation("FCFS", FcfsPolicy(), verboseMode);
 }
 
-void Simulator::runSJF(bool detailedMode, bool verboseMode) {
+Statistics Simulator::runSJF(bool verboseMode) {
     resetSimulation();
-    runSimulation(
-        "SJF", 
-        [this](int currentTime) { return selectShortestJobFirst(currentTime); },
-        false, // non-preemptive
-        0,     // no time quantum
-        detailedMode,
-        verboseMode
-    );
+    return runSimulation("SJF", SjfPolicy(), verboseMode);
 }
 
-void Simulator::runSRTN(bool detailedMode, bool verboseMode) {
+Statistics Simulator::runSRTN(bool verboseMode) {
     resetSimulation();
-    runSimulation(
-        "SRTN", 
-        [this](int currentTime) { return selectShortestRemainingTimeNext(currentTime); },
-        true,  // preemptive
-        0,     // no time quantum
-        detailedMode,
-        verboseMode
-    );
+    return runSimulation("SRTN", SrtnPolicy(), verboseMode);
 }
 
-void Simulator::runRR(int timeQuantum, bool detailedMode, bool verboseMode) {
+Statistics Simulator::runRR(int timeQuantum, bool verboseMode) {
     resetSimulation();
-    runSimulation(
-        "RR" + std::to_string(timeQuantum), 
-        [this](int currentTime) { return selectRoundRobin(currentTime); },
-        true,  // preemptive
-        timeQuantum,
-        detailedMode,
-        verboseMode
-    );
-}
-
-void Simulator::runSimulation(
-    const std::string& algorithm, 
-    std::function<Process*(int)> selectNextProcess,
-    bool isPreemptive,
-    int timeQuantum,
-    bool detailedMode, 
-    bool verboseMode
-) {
-    // Schedule process arrival events
-    for (auto& process : processes) {
-        eventQueue.emplace(process.getArrivalTime(), &process, EventType::PROCESS_ARRIVAL);
-    }
-
-    int currentTime = 0;
-    cpuBusyTime = 0;
+    RoundRobinPolicy policy = { timeQuantum };
+    return runSimulation("RR" + std::to_string(timeQuantum), policy, verboseMode);
+}
+
+Statistics Simulator::runMLFQ(const std::vector<int>& quanta, int boostPeriod, const std::string& algorithm,
+                              bool verboseMode) {
+    resetSimulation();
+    MlfqPolicy policy = { quanta, boostPeriod };
+    return runSimulation(algorithm, policy, verboseMode);
+}
+
+Statistics Simulator::runCFS(int targetLatency, int minimumGranularity, const std::string& algorithm,
+                             bool verboseMode) {
+    resetSimulation();
+    CfsPolicy policy = { targetLatency, minimumGranularity };
+    return runSimulation(algorithm, policy, verboseMode);
+}
+
+Statistics Simulator::runLottery(int timeQuantum, bool verboseMode) {
+    resetSimulation();
+    LotteryPolicy policy = { timeQuantum };
+    return runSimulation("LOTTERY" + std::to_string(timeQuantum), policy, verboseMode);
+}
+
+Statistics Simulator::runStride(int timeQuantum, bool verboseMode) {
+    resetSimulation();
+    StridePolicy policy = { timeQuantum };
+    return runSimulation("STRIDE" + std::to_string(timeQuantum), policy, verboseMode);
+}
+
+Statistics Simulator::runEDF(bool verboseMode) {
+    resetSimulation();
+    return runSimulation("EDF", EdfPolicy(), verboseMode);
+}
+
+Statistics Simulator::runRM(bool verboseMode) {
+    resetSimulation();
+    return runSimulation("RM", RateMonotonicPolicy(), verboseMode);
+}
+
+Statistics Simulator::runPriority(bool preemptive, int agingInterval, const std::string& algorithm,
+                                  bool verboseMode) {
+    resetSimulation();
+    if (preemptive) {
+        PriorityPolicy<true> policy = { agingInterval };
+        return runSimulation(algorithm, policy, verboseMode);
+    }
+    PriorityPolicy<false> policy = { agingInterval };
+    return runSimulation(algorithm, policy, verboseMode);
+}
+
+Statistics Simulator::runGeneric(const std::string& algorithm, bool verboseMode) {
+    resetSimulation();
+    GenericPolicy policy;
+    policy.boost = 0;
+    int boostPeriod;
+    int targetLatency;
+    int minimumGranularity;
+    int quantum;
+    bool preemptivePriority;
+    int agingInterval;
+    bool multilevel = parseMlfq(algorithm, policy.quanta, boostPeriod);
+    bool lottery = parseShareQuantum(algorithm, "LOTTERY", quantum);
+    bool stride = parseShareQuantum(algorithm, "STRIDE", quantum);
+    policy.fair = parseCfs(algorithm, targetLatency, minimumGranularity);
+    policy.prioritized = parsePriority(algorithm, preemptivePriority, agingInterval);
+    if (algorithm == "EDF") {
+        policy.urgency = AbsoluteDeadlineKey();
+    } else if (algorithm == "RM") {
+        policy.urgency = RateKey();
+    }
+    policy.preemptive = algorithm == "SRTN" || policy.fair || (policy.prioritized && preemptivePriority) ||
+                        policy.urgency;
+    if (multilevel) {
+        policy.boost = boostPeriod;
+    } else if (policy.prioritized) {
+        policy.boost = agingInterval;
+        policy.quanta.push_back(0);
+    } else if (lottery || stride) {
+        policy.quanta.push_back(quantum);
+    } else if (algorithm.substr(0, 2) == "RR") {
+        policy.quanta.push_back(std::stoi(algorithm.substr(2)));
+    } else {
+        policy.quanta.push_back(0);
+    }
+    policy.timeSliced = multilevel || policy.fair || lottery || stride || algorithm.substr(0, 2) == "RR";
+    int levelCount = static_cast<int>(policy.quanta.size());
+    bool fair = policy.fair;
+    bool prioritized = policy.prioritized;
+    policy.create = [=](const BurstArena& bursts) -> ReadyQueue* {
+        if (multilevel) {
+            return new MultilevelReadyQueue(levelCount);
+        }
+        if (prioritized) {
+            return new PriorityReadyQueue(agingInterval);
+        }
+        if (fair) {
+            return new FairReadyQueue(targetLatency, minimumGranularity);
+        }
+        if (lottery) {
+            return new LotteryReadyQueue();
+        }
+        if (stride) {
+            return new StrideReadyQueue();
+        }
+        if (algorithm == "FCFS") {
+            return new KeyedReadyQueue<KeyFunction>(ArrivalTimeKey());
+        }
+        if (algorithm == "SJF") {
+            return new KeyedReadyQueue<KeyFunction>(BurstDurationKey(bursts));
+        }
+        if (algorithm == "SRTN") {
+            return new KeyedReadyQueue<KeyFunction>(RemainingTimeKey(bursts));
+        }
+        if (algorithm == "EDF") {
+            return new KeyedReadyQueue<KeyFunction>(AbsoluteDeadlineKey());
+        }
+        if (algorithm == "RM") {
+            return new KeyedReadyQueue<KeyFunction>(RateKey());
+        }
+        return new FifoReadyQueue();
+    };
+    return runSimulation(algorithm, policy, verboseMode);
+}
+
+Statistics Simulator::run(const std::string& algorithm, bool verboseMode) {
+    if (algorithm == "FCFS") {
+        return runFCFS(verboseMode);
+    }
+    if (algorithm == "SJF") {
+        return runSJF(verboseMode);
+    }
+    if (algorithm == "SRTN") {
+        return runSRTN(verboseMode);
+    }
+    if (algorithm == "EDF") {
+        return runEDF(verboseMode);
+    }
+    if (algorithm == "RM") {
+        return runRM(verboseMode);
+    }
+    std::vector<int> quanta;
+    int boostPeriod;
+    if (parseMlfq(algorithm, quanta, boostPeriod)) {
+        return runMLFQ(quanta, boostPeriod, algorithm, verboseMode);
+    }
+    int targetLatency;
+    int minimumGranularity;
+    if (parseCfs(algorithm, targetLatency, minimumGranularity)) {
+        return runCFS(targetLatency, minimumGranularity, algorithm, verboseMode);
+    }
+    int quantum;
+    if (parseShareQuantum(algorithm, "LOTTERY", quantum)) {
+        return runLottery(quantum, verboseMode);
+    }
+    if (parseShareQuantum(algorithm, "STRIDE", quantum)) {
+        return runStride(quantum, verboseMode);
+    }
+    bool preemptive;
+    int agingInterval;
+    if (parsePriority(algorithm, preemptive, agingInterval)) {
+        return runPriority(preemptive, agingInterval, algorithm, verboseMode);
+    }
+    return runRR(std::stoi(algorithm.substr(2)), verboseMode);
+}
+
+void Simulator::addTraceWriter(TraceWriter& writer) {
+    traces.push_back(&writer);
+}
+
+void Simulator::setProcessSwitchOverhead(int overhead) {
+    processSwitchOverhead = overhead;
+}
+
+void Simulator::setCoreCount(int cores) {
+    coreCount = cores < 1 ? 1 : cores;
+}
+
+void Simulator::setDevices(int count, DeviceDiscipline discipline) {
+    deviceCount = count < 0 ? 0 : count;
+    deviceDiscipline = discipline;
+}
+
+void Simulator::setProcessStream(ProcessStream* stream) {
+    this->stream = stream;
+}
+
+const std::vector<Process>& Simulator::getProcesses() const {
+    return workload.getProcesses();
+}
+
+template <typename Policy>
+Statistics Simulator::runSimulation(const std::string& algorithm, const Policy& policy, bool verboseMode) {
+    // Set up the CPUs, each with its own ready queue
+    cores.clear();
+    cores.resize(coreCount);
+    for (auto& core : cores) {
+        core.readyQueue.reset(policy.createQueue(workload.getBursts()));
+        core.runningProcess = nullptr;
+        core.runningEvent = EventQueue::INVALID_HANDLE;
+        core.nextProcessTime = 0;
+        core.busyTime = 0;
+        core.migrations = 0;
+        core.dispatches = 0;
+    }
+    devices.clear();
+    devices.resize(deviceCount);
+    for (auto& device : devices) {
+        if (deviceDiscipline == DeviceDiscipline::SSTF) {
+            device.queue.reset(new KeyedReadyQueue<BurstDurationKey>(BurstDurationKey(workload.getBursts())));
+        } else {
+            device.queue.reset(new FifoReadyQueue());
+        }
+        device.servingProcess = nullptr;
+        device.busyTime = 0;
+        device.requests = 0;
+    }
+    
+    // Schedule process arrival events; a stream keeps one arrival pending
+    if (stream != nullptr) {
+        admitNextProcess();
+    } else {
+        std::vector<Process>& processes = workload.getProcesses();
+        for (std::size_t i = 0; i < processes.size(); ++i) {
+            processes[i].setIndex(static_cast<unsigned int>(i));
+            eventQueue->emplace(processes[i].getArrivalTime(), static_cast<unsigned int>(i),
+                                EventType::PROCESS_ARRIVAL);
+        }
+    }
+
+    SimTime currentTime = 0;
+    long long eventCount = 0;
+    SimTime nextBoost = policy.boostPeriod();
+    trackingFairShare = isProportionalShare(algorithm);
+    fairShareClock = 0.0;
+    fairShareTime = 0;
+    runnableWeight = 0;
+    runnableCount = 0;
     
     // Main simulation loop
-    while (!eventQueue.empty()) {
+    while (!eventQueue->empty()) {
+        eventCount++;
+        
         // Get the next event
-        Event event = eventQueue.top();
-        eventQueue.pop();
+        Event event = eventQueue->top();
+        eventQueue->pop();
         
         // Update current time
         currentTime = event.getTime();
-        Process* process = event.getProcess();
+        Process* process = processAt(event.getProcess());
+        
+        // Priority boost, applied before the first event at or after it
+        if (policy.boostPeriod() > 0 && currentTime >= nextBoost) {
+            for (std::size_t c = 0; c < cores.size(); ++c) {
+                readyQueueOf<Policy>(c).boost(currentTime);
+            }
+            nextBoost = (currentTime / policy.boostPeriod() + 1) * policy.boostPeriod();
+        }
+        INSTRUMENT(instrumentation.countEvent(event.getType()));
+        INSTRUMENT(instrumentation.recordEventQueueDepth(eventQueue->size()));
         
         // Handle the event based on its type
         switch (event.getType()) {
             case EventType::PROCESS_ARRIVAL:
-                handleProcessArrival(process, currentTime, verboseMode);
+                handleProcessArrival<Policy>(process, currentTime, verboseMode);
                 break;
                 
             case EventType::CPU_BURST_COMPLETION:
@@ -97,11 +492,11 @@ void Simulator::runSimulation(
                 break;
                 
             case EventType::IO_BURST_COMPLETION:
-                handleIoBurstCompletion(process, currentTime, verboseMode);
+                handleIoBurstCompletion<Policy>(process, currentTime, verboseMode);
                 break;
                 
             case EventType::TIME_SLICE_EXPIRATION:
-                handleTimeSliceExpiration(process, currentTime, verboseMode);
+                handleTimeSliceExpiration<Policy>(process, currentTime, verboseMode);
                 break;
                 
             case EventType::PROCESS_TERMINATED:
@@ -109,162 +504,389 @@ void Simulator::runSimulation(
                 break;
         }
 
-        // Check if we need to schedule a new process on the CPU
-        if (runningProcess == nullptr && !readyQueue.empty()) {
-            // Advance time for process switch overhead if needed
-            if (nextProcessTime > currentTime) {
-                currentTime = nextProcessTime;
-            }
+        for (std::size_t c = 0; c < cores.size(); ++c) {
+            SimTime coreTime = currentTime;
+            INSTRUMENT(instrumentation.recordReadyQueueDepth(readyQueueOf<Policy>(c).size()));
             
-            // Select next process to run
-            Process* nextProcess = selectNextProcess(currentTime);
+            // Check if preemption is needed for SRTN, CFS, preemptive priority, EDF or RM
+            if (policy.preemptive) {
+                preemptIfPreferredReady(c, coreTime, policy, verboseMode);
+            }
             
-            if (nextProcess != nullptr) {
-                nextProcess->setState(ProcessState::RUNNING);
-                nextProcess->setLastStateChangeTime(currentTime);
-                runningProcess = nextProcess;
-                
-                if (verboseMode) {
-                    std::cout << "At time " << currentTime << ": Process " 
-                              << nextProcess->getId() << " moves from " 
-                              << processStateToString(ProcessState::READY) << " to " 
-                              << processStateToString(ProcessState::RUNNING) << std::endl;
-                }
-                
-                // Schedule CPU burst completion event
-                Burst& burst = nextProcess->getCurrentBurst();
-                int completionTime = currentTime + burst.remainingTime;
-                
-                // If using RR, check if time slice will expire before burst completes
-                if (timeQuantum > 0 && burst.remainingTime > timeQuantum) {
-                    // Schedule time slice expiration
-                    eventQueue.emplace(currentTime + timeQuantum, nextProcess, EventType::TIME_SLICE_EXPIRATION);
-                } else {
-                    // Schedule CPU burst completion
-                    eventQueue.emplace(completionTime, nextProcess, EventType::CPU_BURST_COMPLETION);
-                }
+            // Check if we need to schedule a new process on the CPU
+            if (cores[c].runningProcess == nullptr) {
+                dispatch(c, coreTime, policy, verboseMode);
             }
         }
+    }
+    
+    // The trace of this run is complete before its statistics are reported
+    if (verboseMode) {
+        for (auto* writer : traces) {
+            writer->flush();
+        }
+    }
+    
+    // Calculate CPU utilization and total time
+    SimTime cpuBusyTime = 0;
+    long long dispatchCount = 0;
+    std::vector<CoreStatistics> coreStatistics;
+    for (const auto& core : cores) {
+        cpuBusyTime += core.busyTime;
+        dispatchCount += core.dispatches;
+        CoreStatistics statistics = { core.busyTime, core.migrations };
+        coreStatistics.push_back(statistics);
+    }
+    double cpuUtilization = static_cast<double>(cpuBusyTime) / (static_cast<double>(currentTime) * cores.size());
+    
+    Statistics statistics(algorithm, currentTime, cpuUtilization, finishedTotals);
+    statistics.setEventCounts(eventCount, dispatchCount);
+    if (cores.size() > 1) {
+        statistics.setCoreStatistics(coreStatistics);
+    }
+    std::vector<DeviceStatistics> deviceStatistics;
+    for (const auto& device : devices) {
+        DeviceStatistics statistics = { device.busyTime, device.requests, device.queueingDelays };
+        deviceStatistics.push_back(statistics);
+    }
+    statistics.setDeviceStatistics(deviceStatistics);
+    INSTRUMENT(statistics.setInstrumentation(instrumentation));
+    return statistics;
+}
+
+template <typename Policy>
+void Simulator::preemptIfPreferredReady(std::size_t coreIndex, SimTime& currentTime, const Policy& policy,
+                                        bool verboseMode) {
+    INSTRUMENT_SCOPE(instrumentation, PREEMPTION_CHECK);
+    Core& core = cores[coreIndex];
+    typename Policy::Queue& readyQueue = readyQueueOf<Policy>(coreIndex);
+    Process* runningProcess = core.runningProcess;
+    if (runningProcess == nullptr || readyQueue.empty()) {
+        return;
+    }
+    
+    // Dispatch may already have advanced past this event by the switch overhead
+    if (currentTime < runningProcess->getLastStateChangeTime()) {
+        currentTime = runningProcess->getLastStateChangeTime();
+    }
+    
+    BurstArena& bursts = workload.getBursts();
+    int runningBurst = runningProcess->getCurrentBurst();
+    int elapsedTime = static_cast<int>(currentTime - runningProcess->getLastStateChangeTime());
+    int runningRemaining = bursts.getRemainingTime(runningBurst) - elapsedTime;
+    
+    // A burst ending at this very moment is left to complete
+    if (runningRemaining > 0 && policy.preempts(readyQueue, bursts, runningProcess, elapsedTime)) {
+        // Preempt the currently running process
+        INSTRUMENT(instrumentation.countPreemption());
+        bursts.setRemainingTime(runningBurst, runningRemaining);
+        core.busyTime += elapsedTime;
         
-        // Check if preemption is needed for SRTN
-        if (isPreemptive && runningProcess != nullptr && !readyQueue.empty() && algorithm == "SRTN") {
-            Process* shortestProcess = selectShortestRemainingTimeNext(currentTime);
-            
-            if (shortestProcess != nullptr && shortestProcess != runningProcess) {
-                // Preempt the currently running process
-                Burst& runningBurst = runningProcess->getCurrentBurst();
-                int elapsedTime = currentTime - runningProcess->getLastStateChangeTime();
-                runningBurst.remainingTime -= elapsedTime;
-                
-                runningProcess->updateServiceTime(currentTime);
-                runningProcess->setState(ProcessState::READY);
-                runningProcess->setLastStateChangeTime(currentTime);
-                
-                if (verboseMode) {
-                    std::cout << "At time " << currentTime << ": Process " 
-                              << runningProcess->getId() << " moves from " 
-                              << processStateToString(ProcessState::RUNNING) << " to " 
-                              << processStateToString(ProcessState::READY) << " (preempted)" << std::endl;
-                }
-                
-                // Remove the current CPU burst completion event
-                std::priority_queue<Event, std::vector<Event>, EventComparator> tempQueue;
-                while (!eventQueue.empty()) {
-                    Event e = eventQueue.top();
-                    eventQueue.pop();
-                    
-                    if (e.getProcess() != runningProcess || 
-                        (e.getType() != EventType::CPU_BURST_COMPLETION && 
-                         e.getType() != EventType::TIME_SLICE_EXPIRATION)) {
-                        tempQueue.push(e);
-                    }
-                }
-                eventQueue = tempQueue;
-                
-                // Add the preempted process back to the ready queue
-                readyQueue.push_back(runningProcess);
-                runningProcess = nullptr;
-                
-                // Schedule next process after overhead
-                nextProcessTime = currentTime + processSwitchOverhead;
-                
-                // Process the next event
-                continue;
+        runningProcess->updateServiceTime(currentTime);
+        runningProcess->setState(ProcessState::READY);
+        runningProcess->setLastStateChangeTime(currentTime);
+        
+        if (verboseMode) {
+            traceTransition(runningProcess, currentTime, ProcessState::RUNNING, ProcessState::READY,
+                            TraceReason::PREEMPTION);
+        }
+        
+        // Remove the current CPU burst completion event
+        eventQueue->cancel(core.runningEvent);
+        core.runningEvent = EventQueue::INVALID_HANDLE;
+        
+        // Add the preempted process back to the ready queue
+        readyQueue.push(runningProcess);
+        core.runningProcess = nullptr;
+        
+        // Schedule next process after overhead
+        core.nextProcessTime = currentTime + processSwitchOverhead;
+    }
+}
+
+template <typename Policy>
+void Simulator::dispatch(std::size_t coreIndex, SimTime currentTime, const Policy& policy, bool verboseMode) {
+    INSTRUMENT_SCOPE(instrumentation, DISPATCH);
+    Core& core = cores[coreIndex];
+    
+    // An idle core with nothing to run steals from the busiest core
+    typename Policy::Queue* readyQueue = &readyQueueOf<Policy>(coreIndex);
+    if (readyQueue->empty()) {
+        readyQueue = stealSource<Policy>(coreIndex);
+        if (readyQueue == nullptr) {
+            return;
+        }
+    }
+    
+    // Advance time for process switch overhead if needed
+    if (core.nextProcessTime > currentTime) {
+        currentTime = core.nextProcessTime;
+    }
+    
+    // Select next process to run
+    Process* nextProcess = readyQueue->pop();
+    
+    if (nextProcess != nullptr) {
+        nextProcess->recordWait(currentTime - nextProcess->getLastStateChangeTime());
+        int lastCore = nextProcess->getCore();
+        if (lastCore != -1 && lastCore != static_cast<int>(coreIndex)) {
+            core.migrations++;
+        }
+        nextProcess->setCore(static_cast<int>(coreIndex));
+        core.dispatches++;
+        INSTRUMENT(instrumentation.countContextSwitch());
+        
+        nextProcess->setState(ProcessState::RUNNING);
+        nextProcess->setLastStateChangeTime(currentTime);
+        nextProcess->setStartTime(currentTime);
+        core.runningProcess = nextProcess;
+        
+        if (verboseMode) {
+            traceTransition(nextProcess, currentTime, ProcessState::READY, ProcessState::RUNNING,
+                            TraceReason::DISPATCH, cores.size() > 1 ? static_cast<int>(coreIndex) : -1);
+        }
+        
+        // Schedule CPU burst completion event
+        int remainingTime = workload.getBursts().getRemainingTime(nextProcess->getCurrentBurst());
+        SimTime completionTime = currentTime + remainingTime;
+        
+        // If using time slices, check if the slice will expire before burst completes
+        int timeQuantum = policy.timeQuantum(*readyQueue, nextProcess);
+        if (policy.timeSliced && remainingTime > timeQuantum) {
+            // Schedule time slice expiration
+            core.runningEvent = eventQueue->emplace(currentTime + timeQuantum, nextProcess->getIndex(),
+                                                    EventType::TIME_SLICE_EXPIRATION);
+        } else {
+            // Schedule CPU burst completion
+            core.runningEvent = eventQueue->emplace(completionTime, nextProcess->getIndex(),
+                                                    EventType::CPU_BURST_COMPLETION);
+        }
+    }
+}
+
+void Simulator::requestIo(Process* process, SimTime currentTime) {
+    const BurstArena& bursts = workload.getBursts();
+    int burst = process->getCurrentBurst();
+    if (devices.empty()) {
+        // A device of its own: the burst completes after its duration
+        eventQueue->emplace(currentTime + bursts.getDuration(burst), process->getIndex(),
+                            EventType::IO_BURST_COMPLETION);
+        return;
+    }
+    
+    // Named devices wrap around the devices there are; a burst naming none
+    // goes to the least loaded device (queued plus serving, ties to the lowest)
+    std::size_t deviceIndex = 0;
+    if (bursts.getDevice(burst) != BurstArena::ANY_DEVICE) {
+        deviceIndex = bursts.getDevice(burst) % devices.size();
+    } else {
+        std::size_t bestLoad = 0;
+        for (std::size_t d = 0; d < devices.size(); ++d) {
+            std::size_t load = devices[d].queue->size() + (devices[d].servingProcess != nullptr ? 1 : 0);
+            if (d == 0 || load < bestLoad) {
+                deviceIndex = d;
+                bestLoad = load;
             }
         }
     }
     
-    // Calculate CPU utilization and total time
-    double cpuUtilization = static_cast<double>(cpuBusyTime) / currentTime;
+    Device& device = devices[deviceIndex];
+    process->setDevice(static_cast<int>(deviceIndex));
+    device.requests++;
+    if (device.servingProcess == nullptr) {
+        startIo(deviceIndex, process, currentTime);
+    } else {
+        device.queue->push(process);
+    }
+}
+
+void Simulator::startIo(std::size_t deviceIndex, Process* process, SimTime currentTime) {
+    Device& device = devices[deviceIndex];
+    int duration = workload.getBursts().getDuration(process->getCurrentBurst());
+    
+    // The process has been blocked since its request
+    device.queueingDelays.record(currentTime - process->getLastStateChangeTime());
+    device.servingProcess = process;
+    device.busyTime += duration;
+    eventQueue->emplace(currentTime + duration, process->getIndex(), EventType::IO_BURST_COMPLETION);
+}
+
+void Simulator::finishIo(Process* process, SimTime currentTime) {
+    std::size_t deviceIndex = static_cast<std::size_t>(process->getDevice());
+    Device& device = devices[deviceIndex];
+    process->setDevice(-1);
+    device.servingProcess = nullptr;
+    if (!device.queue->empty()) {
+        startIo(deviceIndex, device.queue->pop(), currentTime);
+    }
+}
+
+void Simulator::traceTransition(const Process* process, SimTime currentTime, ProcessState from, ProcessState to,
+                                TraceReason reason, int core) {
+    TraceRecord record = { currentTime, process->getId(), from, to, reason, core };
+    for (auto* writer : traces) {
+        writer->record(record);
+    }
+}
+
+Simulator::Core& Simulator::coreOf(const Process* process) {
+    return cores[process->getCore()];
+}
+
+void Simulator::admitNextProcess() {
+    Process next(0, 0);
+    if (!stream->next(next, workload.getBursts())) {
+        return;
+    }
+    unsigned int slot;
+    if (freeSlots.empty()) {
+        slot = static_cast<unsigned int>(streamedProcesses.size());
+        streamedProcesses.push_back(std::move(next));
+    } else {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        streamedProcesses[slot] = std::move(next);
+    }
+    Process& process = streamedProcesses[slot];
+    process.setIndex(slot);
+    eventQueue->emplace(process.getArrivalTime(), slot, EventType::PROCESS_ARRIVAL);
+}
+
+void Simulator::retireProcess(Process* process) {
+    freeSlots.push_back(process->getIndex());
     
-    // Output statistics
-    Statistics stats(algorithm, currentTime, cpuUtilization, processes);
-    stats.output(detailedMode);
+    // Bursts of retired processes are reclaimed once they make up most of the arena
+    retiredBursts += process->getBurstCount();
+    if (retiredBursts > MIN_RECLAIMED_BURSTS && 2 * retiredBursts > workload.getBursts().size()) {
+        compactBursts();
+    }
 }
 
-void Simulator::handleProcessArrival(Process* process, int currentTime, bool verboseMode) {
+void Simulator::compactBursts() {
+    BurstArena& bursts = workload.getBursts();
+    BurstArena compacted;
+    compacted.reserve(bursts.size() - retiredBursts);
+    for (auto& process : streamedProcesses) {
+        if (process.getState() != ProcessState::TERMINATED) {
+            int first = compacted.append(bursts, process.getFirstBurst(), process.getBurstCount());
+            process.setBursts(first, process.getBurstCount());
+        }
+    }
+    std::swap(bursts, compacted);
+    retiredBursts = 0;
+}
+
+template <typename Policy>
+std::size_t Simulator::leastLoadedCore() {
+    std::size_t best = 0;
+    std::size_t bestLoad = 0;
+    for (std::size_t c = 0; c < cores.size(); ++c) {
+        std::size_t load = readyQueueOf<Policy>(c).size() + (cores[c].runningProcess != nullptr ? 1 : 0);
+        if (c == 0 || load < bestLoad) {
+            best = c;
+            bestLoad = load;
+        }
+    }
+    return best;
+}
+
+template <typename Policy>
+typename Policy::Queue* Simulator::stealSource(std::size_t thiefIndex) {
+    typename Policy::Queue* victim = nullptr;
+    for (std::size_t c = 0; c < cores.size(); ++c) {
+        typename Policy::Queue* candidate = &readyQueueOf<Policy>(c);
+        if (c != thiefIndex && !candidate->empty() &&
+            (victim == nullptr || candidate->size() > victim->size())) {
+            victim = candidate;
+        }
+    }
+    return victim;
+}
+
+template <typename Policy>
+void Simulator::handleProcessArrival(Process* process, SimTime currentTime, bool verboseMode) {
+    INSTRUMENT_SCOPE(instrumentation, ARRIVAL_HANDLER);
     if (verboseMode) {
-        std::cout << "At time " << currentTime << ": Process " 
-                  << process->getId() << " moves from " 
-                  << processStateToString(ProcessState::NEW) << " to " 
-                  << processStateToString(ProcessState::READY) << std::endl;
+        traceTransition(process, currentTime, ProcessState::NEW, ProcessState::READY, TraceReason::ARRIVAL);
     }
     
     process->setState(ProcessState::READY);
     process->setLastStateChangeTime(currentTime);
-    readyQueue.push_back(process);
+    process->releaseJob(currentTime);
+    if (trackingFairShare) {
+        startFairShare(process, currentTime);
+    }
+    readyQueueOf<Policy>(leastLoadedCore<Policy>()).push(process);
+    
+    if (stream != nullptr) {
+        admitNextProcess();
+    }
 }
 
-void Simulator::handleCpuBurstCompletion(Process* process, int currentTime, bool verboseMode) {
+void Simulator::handleCpuBurstCompletion(Process* process, SimTime currentTime, bool verboseMode) {
+    INSTRUMENT_SCOPE(instrumentation, CPU_BURST_COMPLETION_HANDLER);
+    Core& core = coreOf(process);
+    
     // Update process stats
     process->updateServiceTime(currentTime);
-    cpuBusyTime += (currentTime - process->getLastStateChangeTime());
+    core.busyTime += (currentTime - process->getLastStateChangeTime());
+    if (trackingFairShare) {
+        stopFairShare(process, currentTime);
+    }
+    if (process->getAbsoluteDeadline() != Process::NO_DEADLINE) {
+        finishedTotals.addJob(currentTime - process->getAbsoluteDeadline());
+    }
     
     process->moveToNextBurst();
     
     // Check if process has completed all bursts
     if (process->isCompleted()) {
         if (verboseMode) {
-            std::cout << "At time " << currentTime << ": Process " 
-                      << process->getId() << " moves from " 
-                      << processStateToString(ProcessState::RUNNING) << " to " 
-                      << processStateToString(ProcessState::TERMINATED) << std::endl;
+            traceTransition(process, currentTime, ProcessState::RUNNING, ProcessState::TERMINATED,
+                            TraceReason::TERMINATION);
         }
         
         process->setState(ProcessState::TERMINATED);
         process->setFinishTime(currentTime);
+        finishedTotals.add(*process, workload.getBursts());
         
         // Remove from running
-        runningProcess = nullptr;
+        core.runningProcess = nullptr;
         
         // Set next process time with overhead
-        nextProcessTime = currentTime + processSwitchOverhead;
+        core.nextProcessTime = currentTime + processSwitchOverhead;
+        
+        if (stream != nullptr) {
+            retireProcess(process);
+        }
     } else {
         // Process still has more bursts
         if (verboseMode) {
-            std::cout << "At time " << currentTime << ": Process " 
-                      << process->getId() << " moves from " 
-                      << processStateToString(ProcessState::RUNNING) << " to " 
-                      << processStateToString(ProcessState::BLOCKED) << std::endl;
+            traceTransition(process, currentTime, ProcessState::RUNNING, ProcessState::BLOCKED,
+                            TraceReason::IO_REQUEST);
         }
         
         process->setState(ProcessState::BLOCKED);
         process->setLastStateChangeTime(currentTime);
         
-        // Schedule IO completion
-        Burst& ioBurst = process->getCurrentBurst();
-        int ioCompletionTime = currentTime + ioBurst.duration;
-        eventQueue.emplace(ioCompletionTime, process, EventType::IO_BURST_COMPLETION);
+        // Start or queue the IO burst
+        requestIo(process, currentTime);
         
         // Remove from running
-        runningProcess = nullptr;
+        core.runningProcess = nullptr;
         
         // Set next process time with overhead
-        nextProcessTime = currentTime + processSwitchOverhead;
+        core.nextProcessTime = currentTime + processSwitchOverhead;
     }
 }
 
-void Simulator::handleIoBurstCompletion(Process* process, int currentTime, bool verboseMode) {
+template <typename Policy>
+void Simulator::handleIoBurstCompletion(Process* process, SimTime currentTime, bool verboseMode) {
+    INSTRUMENT_SCOPE(instrumentation, IO_BURST_COMPLETION_HANDLER);
+    if (!devices.empty()) {
+        finishIo(process, currentTime);
+    }
+    
     // Update IO time
     process->updateIOTime(currentTime);
     
@@ -272,132 +894,97 @@ void Simulator::handleIoBurstCompletion(Process* process, int currentTime, bool
     process->moveToNextBurst();
     
     if (verboseMode) {
-        std::cout << "At time " << currentTime << ": Process " 
-                  << process->getId() << " moves from " 
-                  << processStateToString(ProcessState::BLOCKED) << " to " 
-                  << processStateToString(ProcessState::READY) << std::endl;
+        traceTransition(process, currentTime, ProcessState::BLOCKED, ProcessState::READY,
+                        TraceReason::IO_COMPLETION);
     }
     
     // Update process state
     process->setState(ProcessState::READY);
     process->setLastStateChangeTime(currentTime);
+    process->releaseJob(currentTime);
+    if (trackingFairShare) {
+        startFairShare(process, currentTime);
+    }
     
-    // Add to ready queue
-    readyQueue.push_back(process);
+    // Add to the ready queue of the core it last ran on
+    readyQueueOf<Policy>(process->getCore()).push(process);
 }
 
-void Simulator::handleTimeSliceExpiration(Process* process, int currentTime, bool verboseMode) {
+template <typename Policy>
+void Simulator::handleTimeSliceExpiration(Process* process, SimTime currentTime, bool verboseMode) {
+    INSTRUMENT_SCOPE(instrumentation, TIME_SLICE_EXPIRATION_HANDLER);
+    Core& core = coreOf(process);
+    
     // Process is still running, preempt it
-    if (runningProcess == process && process->getState() == ProcessState::RUNNING) {
+    if (core.runningProcess == process && process->getState() == ProcessState::RUNNING) {
+        INSTRUMENT(instrumentation.countPreemption());
         // Update process stats
         process->updateServiceTime(currentTime);
-        cpuBusyTime += (currentTime - process->getLastStateChangeTime());
+        core.busyTime += (currentTime - process->getLastStateChangeTime());
         
         // Update remaining time for current burst
-        Burst& burst = process->getCurrentBurst();
-        int elapsedTime = currentTime - process->getLastStateChangeTime();
-        burst.remainingTime -= elapsedTime;
+        BurstArena& bursts = workload.getBursts();
+        int burst = process->getCurrentBurst();
+        int elapsedTime = static_cast<int>(currentTime - process->getLastStateChangeTime());
+        bursts.setRemainingTime(burst, bursts.getRemainingTime(burst) - elapsedTime);
         
         if (verboseMode) {
-            std::cout << "At time " << currentTime << ": Process " 
-                      << process->getId() << " moves from " 
-                      << processStateToString(ProcessState::RUNNING) << " to " 
-                      << processStateToString(ProcessState::READY) << " (time slice expired)" << std::endl;
+            traceTransition(process, currentTime, ProcessState::RUNNING, ProcessState::READY,
+                            TraceReason::TIME_SLICE_EXPIRATION);
         }
         
         // Update process state
         process->setState(ProcessState::READY);
         process->setLastStateChangeTime(currentTime);
         
-        // Add to ready queue
-        readyQueue.push_back(process);
+        // Add to ready queue, a multilevel queue demotes it
+        readyQueueOf<Policy>(process->getCore()).requeue(process);
         
         // Remove from running
-        runningProcess = nullptr;
+        core.runningProcess = nullptr;
         
         // Set next process time with overhead
-        nextProcessTime = currentTime + processSwitchOverhead;
+        core.nextProcessTime = currentTime + processSwitchOverhead;
     }
 }
 
-Process* Simulator::selectFirstComeFirstServe(int currentTime) {
-    if (readyQueue.empty()) {
-        return nullptr;
-    }
-    
-    // Find the process that arrived first
-    auto minArrivalIt = std::min_element(readyQueue.begin(), readyQueue.end(),
-        [](Process* a, Process* b) {
-            return a->getArrivalTime() < b->getArrivalTime();
-        });
-    
-    Process* selectedProcess = *minArrivalIt;
-    readyQueue.erase(minArrivalIt);
-    
-    return selectedProcess;
-}
-
-Process* Simulator::selectShortestJobFirst(int currentTime) {
-    if (readyQueue.empty()) {
-        return nullptr;
+void Simulator::advanceFairShareClock(SimTime currentTime) {
+    // Runnable processes share the CPUs in proportion to their weights; with
+    // fewer processes than CPUs only as many CPUs count
+    if (runnableWeight > 0) {
+        double cpus = static_cast<double>(std::min(cores.size(), runnableCount));
+        fairShareClock += static_cast<double>(currentTime - fairShareTime) * cpus / runnableWeight;
     }
-    
-    // Find the process with the shortest current CPU burst
-    auto shortestBurstIt = std::min_element(readyQueue.begin(), readyQueue.end(),
-        [](Process* a, Process* b) {
-            return a->getCurrentBurst().duration < b->getCurrentBurst().duration;
-        });
-    
-    Process* selectedProcess = *shortestBurstIt;
-    readyQueue.erase(shortestBurstIt);
-    
-    return selectedProcess;
+    fairShareTime = currentTime;
 }
 
-Process* Simulator::selectShortestRemainingTimeNext(int currentTime) {
-    if (readyQueue.empty()) {
-        return nullptr;
-    }
-    
-    // Find the process with the shortest remaining time in current CPU burst
-    auto shortestRemainingIt = std::min_element(readyQueue.begin(), readyQueue.end(),
-        [](Process* a, Process* b) {
-            return a->getCurrentBurst().remainingTime < b->getCurrentBurst().remainingTime;
-        });
-    
-    Process* selectedProcess = *shortestRemainingIt;
-    readyQueue.erase(shortestRemainingIt);
-    
-    return selectedProcess;
+void Simulator::startFairShare(Process* process, SimTime currentTime) {
+    advanceFairShareClock(currentTime);
+    process->startFairShare(fairShareClock);
+    runnableWeight += process->getWeight();
+    runnableCount++;
 }
 
-Process* Simulator::selectRoundRobin(int currentTime) {
-    if (readyQueue.empty()) {
-        return nullptr;
-    }
-    
-    // Round-robin simply takes the next process in the queue
-    Process* selectedProcess = readyQueue.front();
-    readyQueue.erase(readyQueue.begin());
-    
-    return selectedProcess;
+void Simulator::stopFairShare(Process* process, SimTime currentTime) {
+    advanceFairShareClock(currentTime);
+    process->stopFairShare(fairShareClock);
+    runnableWeight -= process->getWeight();
+    runnableCount--;
 }
 
 void Simulator::resetSimulation() {
     // Clear event and ready queues
-    while (!eventQueue.empty()) {
-        eventQueue.pop();
-    }
-    readyQueue.clear();
+    eventQueue->clear();
+    cores.clear();
+    streamedProcesses.clear();
+    freeSlots.clear();
+    finishedTotals = ProcessTotals();
+    INSTRUMENT(instrumentation = Instrumentation());
+    retiredBursts = 0;
     
-    // Reset processes
-    for (auto& process : processes) {
-        process.reset();
+    // Reset processes and their bursts; a streaming run starts empty
+    if (stream != nullptr) {
+        workload.clear();
     }
-    
-    // Reset simulator state
-    runningProcess = nullptr;
-    lastReadyQueueIndex = 0;
-    nextProcessTime = 0;
-    cpuBusyTime = 0;
+    workload.reset();
 }
\ No newline at end of file
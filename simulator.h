@@ -2,67 +2,206 @@
 #define SIMULATOR_H
 
 #include <vector>
-#include <queue>
+#include <deque>
+#include <memory>
 #include <string>
 #include <functional>
 #include "process.h"
+#include "workload.h"
 #include "event.h"
-
-// Custom comparator for event priority queue
-struct EventComparator {
-    bool operator()(const Event& a, const Event& b) const {
-        return a > b;
-    }
-};
+#include "event_queue.h"
+#include "ready_queue.h"
+#include "statistics.h"
+#include "process_stream.h"
+#include "trace_writer.h"
+#include "instrumentation.h"
 
 class Simulator {
 public:
-    Simulator(std::vector<Process>& processes, int processSwitchOverhead);
+    Simulator(const Workload& workload, int processSwitchOverhead,
+              const std::string& eventQueueKind = "heap");
     
     // Run different scheduling algorithms
-    void runFCFS(bool detailedMode, bool verboseMode);
-    void runSJF(bool detailedMode, bool verboseMode);
-    void runSRTN(bool detailedMode, bool verboseMode);
-    void runRR(int timeQuantum, bool detailedMode, bool verboseMode);
+    Statistics runFCFS(bool verboseMode);
+    Statistics runSJF(bool verboseMode);
+    Statistics runSRTN(bool verboseMode);
+    Statistics runRR(int timeQuantum, bool verboseMode);
+    
+    // Multilevel feedback queue with one quantum per level and a periodic
+    // priority boost; algorithm is the name reported in the statistics
+    Statistics runMLFQ(const std::vector<int>& quanta, int boostPeriod, const std::string& algorithm,
+                       bool verboseMode);
+    
+    // Completely fair scheduler: slices share the target latency out by
+    // weight, no shorter than the minimum granularity
+    Statistics runCFS(int targetLatency, int minimumGranularity, const std::string& algorithm, bool verboseMode);
+    
+    // Proportional share with a fixed quantum: lottery draws weighted by
+    // tickets, stride runs the smallest pass
+    Statistics runLottery(int timeQuantum, bool verboseMode);
+    Statistics runStride(int timeQuantum, bool verboseMode);
+    
+    // Priority scheduling, preemptive or not; a waiting process rises one
+    // priority per aging interval (0 for no aging)
+    Statistics runPriority(bool preemptive, int agingInterval, const std::string& algorithm, bool verboseMode);
+    
+    // Real-time scheduling, preemptive: earliest deadline first, and rate
+    // monotonic (shortest period first)
+    Statistics runEDF(bool verboseMode);
+    Statistics runRM(bool verboseMode);
+    
+    // Run an algorithm by name (FCFS, SJF, SRTN, RR<quantum>, MLFQ..., CFS...,
+    // LOTTERY..., STRIDE..., PRIO..., PPRIO..., EDF or RM)
+    Statistics run(const std::string& algorithm, bool verboseMode);
+    
+    // Same as run, with the policy decided at run time behind the ready
+    // queue interface instead of a loop specialised for it; for benchmarks
+    Statistics runGeneric(const std::string& algorithm, bool verboseMode);
+    
+    // Sink receiving the state transitions of verbose runs; several can be
+    // attached, each is flushed at the end of every verbose run
+    void addTraceWriter(TraceWriter& writer);
+    
+    // Change the process switch overhead for subsequent runs
+    void setProcessSwitchOverhead(int overhead);
+    
+    // Number of CPUs simulated in subsequent runs (1 by default)
+    void setCoreCount(int cores);
+    
+    // Shared I/O devices of subsequent runs: I/O bursts queue for one of
+    // count devices, served in the given order. With 0 (the default) every
+    // I/O burst has a device of its own and never waits.
+    void setDevices(int count, DeviceDiscipline discipline);
+    
+    // Pull arrivals from a stream, in arrival order, instead of the process
+    // list. Terminated processes are folded into running totals and their
+    // slots reused, so memory follows the processes in the system. A stream
+    // serves a single run.
+    void setProcessStream(ProcessStream* stream);
+    
+    // Processes as left by the last run, for per-process reports
+    const std::vector<Process>& getProcesses() const;
     
 private:
-    std::vector<Process> processes;
+    Workload workload;
     int processSwitchOverhead;
+    std::vector<TraceWriter*> traces;
     
-    // Core simulation method
-    void runSimulation(
-        const std::string& algorithm, 
-        std::function<Process*(int)> selectNextProcess,
-        bool isPreemptive,
-        int timeQuantum,
-        bool detailedMode, 
-        bool verboseMode
-    );
+    // One simulated CPU with its own running slot and ready queue
+    struct Core {
+        std::unique_ptr<ReadyQueue> readyQueue;
+        Process* runningProcess;
+        EventQueue::Handle runningEvent; // Pending completion/expiration of runningProcess
+        SimTime nextProcessTime;
+        SimTime busyTime;
+        int migrations;                  // Dispatches of processes that last ran elsewhere
+        long long dispatches;
+    };
+    
+    // One shared I/O device, serving one burst at a time and queueing the
+    // processes waiting for it
+    struct Device {
+        std::unique_ptr<ReadyQueue> queue;
+        Process* servingProcess;
+        SimTime busyTime;
+        long long requests;
+        LatencyHistogram queueingDelays;
+    };
+    
+    // Core simulation method, compiled once per scheduling policy (see
+    // simulator.cpp): the policy gives every core its ready queue, which
+    // decides the dispatch order, and fixes preemption and time slicing
+    template <typename Policy>
+    Statistics runSimulation(const std::string& algorithm, const Policy& policy, bool verboseMode);
+    
+    // Ready queue of a core as the concrete type of the policy
+    template <typename Policy>
+    typename Policy::Queue& readyQueueOf(std::size_t coreIndex) {
+        return static_cast<typename Policy::Queue&>(*cores[coreIndex].readyQueue);
+    }
     
     // Process state transition helpers
-    void handleProcessArrival(Process* process, int currentTime, bool verboseMode);
-    void handleCpuBurstCompletion(Process* process, int currentTime, bool verboseMode);
-    void handleIoBurstCompletion(Process* process, int currentTime, bool verboseMode);
-    void handleTimeSliceExpiration(Process* process, int currentTime, bool verboseMode);
+    template <typename Policy>
+    void handleProcessArrival(Process* process, SimTime currentTime, bool verboseMode);
+    void handleCpuBurstCompletion(Process* process, SimTime currentTime, bool verboseMode);
+    template <typename Policy>
+    void handleIoBurstCompletion(Process* process, SimTime currentTime, bool verboseMode);
+    template <typename Policy>
+    void handleTimeSliceExpiration(Process* process, SimTime currentTime, bool verboseMode);
     
-    // Process selection strategies
-    Process* selectFirstComeFirstServe(int currentTime);
-    Process* selectShortestJobFirst(int currentTime);
-    Process* selectShortestRemainingTimeNext(int currentTime);
-    Process* selectRoundRobin(int currentTime);
+    // Per-core scheduling decisions taken after every event
+    template <typename Policy>
+    void preemptIfPreferredReady(std::size_t coreIndex, SimTime& currentTime, const Policy& policy,
+                                 bool verboseMode);
+    template <typename Policy>
+    void dispatch(std::size_t coreIndex, SimTime currentTime, const Policy& policy, bool verboseMode);
+    
+    // I/O on the shared devices: a CPU burst ends with a request, which is
+    // served at once or queued; a completion frees the device for the next
+    void requestIo(Process* process, SimTime currentTime);
+    void startIo(std::size_t deviceIndex, Process* process, SimTime currentTime);
+    void finishIo(Process* process, SimTime currentTime);
+    
+    // Record a state transition in every attached trace
+    void traceTransition(const Process* process, SimTime currentTime, ProcessState from, ProcessState to,
+                         TraceReason reason, int core = -1);
+    
+    // Core bookkeeping
+    Core& coreOf(const Process* process);
+    
+    // Process an event refers to, by its slot in the workload or the stream
+    Process* processAt(unsigned int index) {
+        return stream != nullptr ? &streamedProcesses[index] : &workload.getProcesses()[index];
+    }
+    
+    // Streaming runs: keep the next arrival scheduled, recycle finished processes
+    void admitNextProcess();
+    void retireProcess(Process* process);
+    void compactBursts();
+    template <typename Policy>
+    std::size_t leastLoadedCore();
+    template <typename Policy>
+    typename Policy::Queue* stealSource(std::size_t thiefIndex);
+    
+    // Ideal proportional share of the runnable processes, for the fairness
+    // report of proportional-share runs: the clock is the service due so far
+    // to one unit of weight that was runnable throughout
+    void advanceFairShareClock(SimTime currentTime);
+    void startFairShare(Process* process, SimTime currentTime);
+    void stopFairShare(Process* process, SimTime currentTime);
     
     // Reset simulation state
     void resetSimulation();
     
-    // Event queue and ready queue
-    std::priority_queue<Event, std::vector<Event>, EventComparator> eventQueue;
-    std::vector<Process*> readyQueue;
+    // Event queue and CPUs
+    std::unique_ptr<EventQueue> eventQueue;
+    std::vector<Core> cores;
+    int coreCount;
+    
+    // Shared I/O devices, none when deviceCount is 0
+    std::vector<Device> devices;
+    int deviceCount;
+    DeviceDiscipline deviceDiscipline;
+    
+    // Streaming state
+    ProcessStream* stream;
+    std::deque<Process> streamedProcesses;  // Slots of admitted processes
+    std::vector<unsigned int> freeSlots;    // Slots of retired processes
+    std::size_t retiredBursts;              // Arena entries owned by retired processes
+    
+    // Time distributions, fed as processes terminate
+    ProcessTotals finishedTotals;
+    
+    // Fair share state
+    bool trackingFairShare;
+    double fairShareClock;
+    SimTime fairShareTime;
+    long long runnableWeight;
+    std::size_t runnableCount;
     
-    // Simulation state
-    Process* runningProcess;
-    int lastReadyQueueIndex;
-    int nextProcessTime;
-    int cpuBusyTime;
+#ifdef SIM_INSTRUMENT
+    Instrumentation instrumentation;
+#endif
 };
 
 #endif // SIMULATOR_H
\ No newline at end of file
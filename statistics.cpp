@@ -1,21 +1,156 @@
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <iomanip>
 #include "statistics.h"
 #include "types.h"
 
-Statistics::Statistics(const std::string& algorithm, int totalTime, 
-                      double cpuUtilization, const std::vector<Process>& processes)
+ProcessTotals::ProcessTotals()
+    : jobs(0), missedJobs(0), latenessSum(0), maxLateness(0), tasks(0), utilization(0.0) {}
+
+void ProcessTotals::add(const Process& process, const BurstArena& bursts) {
+    SimTime turnaroundTime = process.getTurnaroundTime();
+    if (turnaroundTime < 0) {
+        return;
+    }
+    turnaroundTimes.record(turnaroundTime);
+    waitingTimes.record(turnaroundTime - process.getTotalServiceTime() - process.getTotalIOTime());
+    responseTimes.record(process.getStartTime() - process.getArrivalTime());
+    
+    std::size_t priority = static_cast<std::size_t>(process.getPriority());
+    if (priority >= priorityWaits.size()) {
+        PriorityWaits none = { 0, 0 };
+        priorityWaits.resize(priority + 1, none);
+    }
+    priorityWaits[priority].processes++;
+    priorityWaits[priority].maxWait = std::max(priorityWaits[priority].maxWait, process.getLongestWait());
+    
+    if (process.getRelativeDeadline() != 0) {
+        int longestBurst = 0;
+        for (int b = process.getFirstBurst(); b < process.getFirstBurst() + process.getBurstCount(); ++b) {
+            if (bursts.getType(b) == BurstType::CPU) {
+                longestBurst = std::max(longestBurst, bursts.getDuration(b));
+            }
+        }
+        int interval = process.getRelativeDeadline();
+        if (process.getPeriod() != 0) {
+            interval = std::min(interval, process.getPeriod());
+        }
+        tasks++;
+        utilization += static_cast<double>(longestBurst) / interval;
+    }
+}
+
+void ProcessTotals::addJob(SimTime lateness) {
+    if (jobs == 0 || lateness > maxLateness) {
+        maxLateness = lateness;
+    }
+    jobs++;
+    latenessSum += lateness;
+    if (lateness > 0) {
+        missedJobs++;
+    }
+    tardiness.record(lateness > 0 ? lateness : 0);
+}
+
+Statistics::Statistics(const std::string& algorithm, SimTime totalTime, 
+                      double cpuUtilization, const ProcessTotals& totals)
     : algorithm(algorithm), 
       totalTime(totalTime), 
       cpuUtilization(cpuUtilization), 
-      processes(processes) {}
+      totals(totals), 
+      eventCount(0), 
+      dispatchCount(0) {}
 
-void Statistics::output(bool detailedMode) const {
+void Statistics::output(bool detailedMode, bool percentileMode) const {
     if (detailedMode) {
         outputDetailed();
     } else {
         outputDefault();
     }
+    if (percentileMode) {
+        outputPercentiles();
+    }
+#ifdef SIM_INSTRUMENT
+    instrumentation.writeJson(std::cout, algorithm);
+#endif
+}
+
+void Statistics::outputProcesses(const std::vector<Process>& processes, std::ostream& out, bool fairness) {
+    for (const auto& process : processes) {
+        out << "Process " << process.getId() << ":" << std::endl;
+        out << "  arrival time: " << process.getArrivalTime() << " units" << std::endl;
+        out << "  service time: " << process.getTotalServiceTime() << " units" << std::endl;
+        out << "  I/O time: " << process.getTotalIOTime() << " units" << std::endl;
+        out << "  turnaround time: " << process.getTurnaroundTime() << " units" << std::endl;
+        out << "  finish time: " << process.getFinishTime() << " units" << std::endl;
+        if (fairness) {
+            double error = process.getTotalServiceTime() - process.getFairShare();
+            out << "  share: " << process.getWeight() << std::endl;
+            out << "  fair share: " << std::fixed << std::setprecision(1) << process.getFairShare() << " units"
+                << std::endl;
+            out << "  fairness error: " << std::showpos << error << std::noshowpos << " units" << std::endl;
+        }
+    }
+}
+
+const std::string& Statistics::getAlgorithm() const {
+    return algorithm;
+}
+
+SimTime Statistics::getTotalTime() const {
+    return totalTime;
+}
+
+double Statistics::getCpuUtilization() const {
+    return cpuUtilization;
+}
+
+double Statistics::getMeanTurnaroundTime() const {
+    return totals.turnaroundTimes.getMean();
+}
+
+long long Statistics::getTurnaroundPercentile(double percentile) const {
+    return totals.turnaroundTimes.getPercentile(percentile);
+}
+
+const ProcessTotals& Statistics::getTotals() const {
+    return totals;
+}
+
+void Statistics::setEventCounts(long long events, long long dispatches) {
+    eventCount = events;
+    dispatchCount = dispatches;
+}
+
+long long Statistics::getEventCount() const {
+    return eventCount;
+}
+
+long long Statistics::getDispatchCount() const {
+    return dispatchCount;
+}
+
+#ifdef SIM_INSTRUMENT
+void Statistics::setInstrumentation(const Instrumentation& instrumentation) {
+    this->instrumentation = instrumentation;
+}
+#endif
+
+void Statistics::setCoreStatistics(const std::vector<CoreStatistics>& cores) {
+    this->cores = cores;
+}
+
+const std::vector<CoreStatistics>& Statistics::getCoreStatistics() const {
+    return cores;
+}
+
+void Statistics::setDeviceStatistics(const std::vector<DeviceStatistics>& devices) {
+    this->devices = devices;
+}
+
+const std::vector<DeviceStatistics>& Statistics::getDeviceStatistics() const {
+    return devices;
 }
 
 void Statistics::outputDefault() const {
@@ -23,6 +158,10 @@ void Statistics::outputDefault() const {
     std::cout << "Total Time required is " << totalTime << " time units ";
     std::cout << "CPU Utilization is " << std::fixed << std::setprecision(0) 
               << (cpuUtilization * 100) << "%" << std::endl;
+    outputCores();
+    outputDevices();
+    outputPriorities();
+    outputDeadlines();
 }
 
 void Statistics::outputDetailed() const {
@@ -30,13 +169,87 @@ void Statistics::outputDetailed() const {
     std::cout << "Total Time required is " << totalTime << " units ";
     std::cout << "CPU Utilization is " << std::fixed << std::setprecision(0) 
               << (cpuUtilization * 100) << "%" << std::endl;
+    outputCores();
+    outputDevices();
+    outputPriorities();
+    outputDeadlines();
+}
+
+void Statistics::outputCores() const {
+    for (std::size_t c = 0; c < cores.size(); ++c) {
+        double utilization = totalTime == 0 ? 0.0 : static_cast<double>(cores[c].busyTime) / totalTime;
+        std::cout << "  CPU " << c << ": busy " << cores[c].busyTime << " units ("
+                  << std::fixed << std::setprecision(0) << (utilization * 100) << "%), "
+                  << cores[c].migrations << " migrations" << std::endl;
+    }
+}
+
+void Statistics::outputDevices() const {
+    for (std::size_t d = 0; d < devices.size(); ++d) {
+        double utilization = totalTime == 0 ? 0.0 : static_cast<double>(devices[d].busyTime) / totalTime;
+        const LatencyHistogram& delays = devices[d].queueingDelays;
+        std::cout << "  device " << d << ": busy " << devices[d].busyTime << " units ("
+                  << std::fixed << std::setprecision(0) << (utilization * 100) << "%), "
+                  << devices[d].requests << " requests, queueing delay mean " << std::setprecision(1)
+                  << delays.getMean() << ", p99 " << delays.getPercentile(99) << ", max " << delays.getMax()
+                  << " units" << std::endl;
+    }
+}
+
+void Statistics::outputPriorities() const {
+    // Starvation shows as a long wait in a low priority class
+    if (!isPriorityScheduling(algorithm)) {
+        return;
+    }
+    for (std::size_t p = 0; p < totals.priorityWaits.size(); ++p) {
+        if (totals.priorityWaits[p].processes != 0) {
+            std::cout << "  priority " << p << ": " << totals.priorityWaits[p].processes
+                      << " processes, max wait " << totals.priorityWaits[p].maxWait << " units" << std::endl;
+        }
+    }
+}
+
+void Statistics::outputDeadlines() const {
+    if (totals.jobs == 0) {
+        return;
+    }
+    double missRatio = static_cast<double>(totals.missedJobs) / totals.jobs;
+    std::cout << "  deadlines: " << totals.jobs << " jobs, " << totals.missedJobs << " missed ("
+              << std::fixed << std::setprecision(1) << (missRatio * 100) << "%)" << std::endl;
+    std::cout << "  lateness: mean " << static_cast<double>(totals.latenessSum) / totals.jobs
+              << ", max " << totals.maxLateness << " units; tardiness p50 " << totals.tardiness.getPercentile(50)
+              << ", p90 " << totals.tardiness.getPercentile(90) << ", p99 " << totals.tardiness.getPercentile(99)
+              << " units" << std::endl;
     
-    for (const auto& process : processes) {
-        std::cout << "Process " << process.getId() << ":" << std::endl;
-        std::cout << "  arrival time: " << process.getArrivalTime() << " units" << std::endl;
-        std::cout << "  service time: " << process.getTotalServiceTime() << " units" << std::endl;
-        std::cout << "  I/O time: " << process.getTotalIOTime() << " units" << std::endl;
-        std::cout << "  turnaround time: " << process.getTurnaroundTime() << " units" << std::endl;
-        std::cout << "  finish time: " << process.getFinishTime() << " units" << std::endl;
-    }
-}
\ No newline at end of file
+    // Liu and Layland utilization bounds for one CPU: sufficient for rate
+    // monotonic, exact for EDF when deadlines equal periods
+    if (totals.tasks > 0) {
+        double n = totals.tasks;
+        double rateMonotonicBound = n * (std::pow(2.0, 1.0 / n) - 1.0);
+        std::cout << "  schedulability: utilization " << std::setprecision(3) << totals.utilization << " of "
+                  << totals.tasks << " tasks, EDF bound 1.000 ("
+                  << (totals.utilization <= 1.0 ? "schedulable" : "not guaranteed")
+                  << "), rate-monotonic bound " << rateMonotonicBound << " ("
+                  << (totals.utilization <= rateMonotonicBound ? "schedulable" : "not guaranteed") << ")"
+                  << std::endl;
+    }
+}
+
+void Statistics::outputPercentiles() const {
+    const struct {
+        const char* name;
+        const LatencyHistogram& times;
+    } distributions[] = {
+        { "turnaround", totals.turnaroundTimes },
+        { "waiting", totals.waitingTimes },
+        { "response", totals.responseTimes },
+    };
+    for (const auto& distribution : distributions) {
+        const LatencyHistogram& times = distribution.times;
+        std::cout << "  " << distribution.name << " time: mean " << std::fixed << std::setprecision(1)
+                  << times.getMean() << ", p50 " << times.getPercentile(50)
+                  << ", p90 " << times.getPercentile(90) << ", p99 " << times.getPercentile(99)
+                  << ", p99.9 " << times.getPercentile(99.9) << ", max " << times.getMax()
+                  << " units" << std::endl;
+    }
+}
@@ -3,25 +3,121 @@
 
 #include <vector>
 #include <string>
+#include <ostream>
 #include "process.h"
+#include "burst_arena.h"
+#include "latency_histogram.h"
+#include "instrumentation.h"
+
+// Per-CPU totals of a multi-core run
+struct CoreStatistics {
+    SimTime busyTime;
+    int migrations;     // dispatches of a process last run on another CPU
+};
+
+// Per-device totals of a run with shared I/O devices
+struct DeviceStatistics {
+    SimTime busyTime;
+    long long requests;
+    LatencyHistogram queueingDelays;    // request to start of service
+};
+
+// Finished processes of one priority and the longest any of them waited in
+// a ready queue at a stretch
+struct PriorityWaits {
+    long long processes;
+    SimTime maxWait;
+};
+
+// Time distributions over finished processes, fed as each one terminates,
+// and the jobs of processes with deadlines, fed as each CPU burst completes
+struct ProcessTotals {
+    LatencyHistogram turnaroundTimes;
+    LatencyHistogram waitingTimes;      // turnaround not spent on the CPU or in I/O
+    LatencyHistogram responseTimes;     // arrival to first dispatch
+    std::vector<PriorityWaits> priorityWaits;   // Indexed by priority, up to the highest seen
+    
+    long long jobs;
+    long long missedJobs;
+    long long latenessSum;
+    SimTime maxLateness;
+    LatencyHistogram tardiness;         // lateness of every job, 0 if it met its deadline
+    
+    // Real-time tasks among the finished processes, and the sum of their
+    // longest CPU burst over their period (or relative deadline if shorter)
+    int tasks;
+    double utilization;
+    
+    ProcessTotals();
+    
+    void add(const Process& process, const BurstArena& bursts);
+    
+    // A job completed lateness after its deadline (negative if early)
+    void addJob(SimTime lateness);
+};
 
 class Statistics {
 public:
-    Statistics(const std::string& algorithm, int totalTime, 
-               double cpuUtilization, const std::vector<Process>& processes);
+    Statistics(const std::string& algorithm, SimTime totalTime, 
+               double cpuUtilization, const ProcessTotals& totals);
+    
+    // Output statistics based on mode, with the time percentiles if requested
+    void output(bool detailedMode, bool percentileMode = false) const;
+    
+    // Per-process lines of detailed mode; proportional-share runs add each
+    // process's share and how far its service time is from its fair share
+    static void outputProcesses(const std::vector<Process>& processes, std::ostream& out,
+                                bool fairness = false);
+    
+    // Getters
+    const std::string& getAlgorithm() const;
+    SimTime getTotalTime() const;
+    double getCpuUtilization() const;
+    
+    // Turnaround time summary over processes that finished
+    double getMeanTurnaroundTime() const;
+    long long getTurnaroundPercentile(double percentile) const;
+    const ProcessTotals& getTotals() const;
+    
+    // Simulation work: events processed and processes dispatched
+    void setEventCounts(long long events, long long dispatches);
+    long long getEventCount() const;
+    long long getDispatchCount() const;
+    
+#ifdef SIM_INSTRUMENT
+    // Hot-path measurements, written as JSON after the statistics
+    void setInstrumentation(const Instrumentation& instrumentation);
+#endif
+    
+    // Per-CPU totals, empty for a single-CPU run
+    void setCoreStatistics(const std::vector<CoreStatistics>& cores);
+    const std::vector<CoreStatistics>& getCoreStatistics() const;
     
-    // Output statistics based on mode
-    void output(bool detailedMode) const;
+    // Per-device totals, empty without shared I/O devices
+    void setDeviceStatistics(const std::vector<DeviceStatistics>& devices);
+    const std::vector<DeviceStatistics>& getDeviceStatistics() const;
     
 private:
     std::string algorithm;
-    int totalTime;
+    SimTime totalTime;
     double cpuUtilization;
-    std::vector<Process> processes;
+    ProcessTotals totals;
+    long long eventCount;
+    long long dispatchCount;
+    std::vector<CoreStatistics> cores;
+    std::vector<DeviceStatistics> devices;
+#ifdef SIM_INSTRUMENT
+    Instrumentation instrumentation;
+#endif
     
     // Helper methods for formatting output
     void outputDefault() const;
     void outputDetailed() const;
+    void outputCores() const;
+    void outputDevices() const;
+    void outputPriorities() const;
+    void outputDeadlines() const;
+    void outputPercentiles() const;
 };
 
 #endif // STATISTICS_H
\ No newline at end of file
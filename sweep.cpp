@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <iomanip>
+#include <sstream>
+#include "sweep.h"
+#include "simulator.h"
+#include "thread_pool.h"
+
+bool SweepRange::parse(const std::string& text) {
+    std::istringstream iss(text);
+    char separator;
+    if (!(iss >> first)) {
+        return false;
+    }
+    last = first;
+    step = 1;
+    if (iss >> separator) {
+        if (separator != ':' || !(iss >> last)) {
+            return false;
+        }
+        if (iss >> separator && (separator != ':' || !(iss >> step))) {
+            return false;
+        }
+    }
+    std::string rest;
+    return !(iss >> rest) && step > 0 && first <= last;
+}
+
+std::vector<int> SweepRange::values() const {
+    std::vector<int> result;
+    for (long long value = first; value <= last; value += step) {
+        result.push_back(static_cast<int>(value));
+    }
+    return result;
+}
+
+SweepEngine::SweepEngine(const Workload& workload, const std::string& eventQueueKind,
+                         int coreCount, int threadCount)
+    : workload(workload),
+      eventQueueKind(eventQueueKind),
+      coreCount(coreCount),
+      threadCount(threadCount),
+      deviceCount(0),
+      deviceDiscipline(DeviceDiscipline::FCFS) {}
+
+void SweepEngine::setDevices(int count, DeviceDiscipline discipline) {
+    deviceCount = count;
+    deviceDiscipline = discipline;
+}
+
+std::vector<SweepResult> SweepEngine::run(const std::vector<SweepPoint>& points) const {
+    std::vector<SweepResult> results(points.size());
+    std::atomic<std::size_t> nextPoint(0);
+
+    // One task per worker, each with its own simulator (and workload copy),
+    // pulling grid points from a shared counter until the grid is done
+    auto worker = [this, &points, &results, &nextPoint]() {
+        Simulator simulator(workload, 0, eventQueueKind);
+        simulator.setCoreCount(coreCount);
+        simulator.setDevices(deviceCount, deviceDiscipline);
+        for (std::size_t i = nextPoint++; i < points.size(); i = nextPoint++) {
+            const SweepPoint& point = points[i];
+            simulator.setProcessSwitchOverhead(point.processSwitchOverhead);
+            Statistics statistics = simulator.run(point.algorithm, false);
+
+            SweepResult& result = results[i];
+            result.point = point;
+            result.totalTime = statistics.getTotalTime();
+            result.cpuUtilization = statistics.getCpuUtilization();
+            result.meanTurnaroundTime = statistics.getMeanTurnaroundTime();
+            result.p50TurnaroundTime = statistics.getTurnaroundPercentile(50);
+            result.p90TurnaroundTime = statistics.getTurnaroundPercentile(90);
+            result.p99TurnaroundTime = statistics.getTurnaroundPercentile(99);
+        }
+    };
+
+    std::size_t workers = std::min<std::size_t>(std::max(threadCount, 1), points.size());
+    if (workers <= 1) {
+        worker();
+        return results;
+    }
+
+    ThreadPool pool(workers);
+    std::vector<std::future<void>> done;
+    for (std::size_t i = 0; i < workers; ++i) {
+        done.push_back(pool.submit(worker));
+    }
+    for (auto& future : done) {
+        future.get();
+    }
+    return results;
+}
+
+void SweepEngine::output(const std::vector<SweepResult>& results, std::ostream& out) {
+    out << "algorithm,quantum,overhead,total_time,cpu_utilization,"
+        << "mean_turnaround,p50_turnaround,p90_turnaround,p99_turnaround" << std::endl;
+    for (const auto& result : results) {
+        out << result.point.algorithm << ","
+            << result.point.quantum << ","
+            << result.point.processSwitchOverhead << ","
+            << result.totalTime << ","
+            << std::fixed << std::setprecision(4) << result.cpuUtilization << ","
+            << std::setprecision(2) << result.meanTurnaroundTime << ","
+            << result.p50TurnaroundTime << ","
+            << result.p90TurnaroundTime << ","
+            << result.p99TurnaroundTime << "\n";
+    }
+    out.flush();
+}
@@ -0,0 +1,63 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include "workload.h"
+
+// Inclusive integer range "first:last[:step]", or a single value
+struct SweepRange {
+    int first;
+    int last;
+    int step;
+
+    // Parse a range; returns false on malformed input
+    bool parse(const std::string& text);
+    std::vector<int> values() const;
+};
+
+// One grid point: an algorithm run with a given process switch overhead
+struct SweepPoint {
+    std::string algorithm;
+    int quantum;        // 0 for algorithms without a time quantum
+    int processSwitchOverhead;
+};
+
+// Summary of one grid point
+struct SweepResult {
+    SweepPoint point;
+    SimTime totalTime;
+    double cpuUtilization;
+    double meanTurnaroundTime;
+    long long p50TurnaroundTime;
+    long long p90TurnaroundTime;
+    long long p99TurnaroundTime;
+};
+
+// Simulates a grid of parameter combinations over one parsed workload,
+// spreading the grid points over a pool of worker threads
+class SweepEngine {
+public:
+    SweepEngine(const Workload& workload, const std::string& eventQueueKind, int coreCount,
+                int threadCount);
+
+    // Shared I/O devices of every simulation (none by default)
+    void setDevices(int count, DeviceDiscipline discipline);
+
+    // Results are returned in the order of the points
+    std::vector<SweepResult> run(const std::vector<SweepPoint>& points) const;
+
+    // Write results as CSV with a header line
+    static void output(const std::vector<SweepResult>& results, std::ostream& out);
+
+private:
+    const Workload& workload;
+    std::string eventQueueKind;
+    int coreCount;
+    int threadCount;
+    int deviceCount;
+    DeviceDiscipline deviceDiscipline;
+};
+
+#endif // SWEEP_H
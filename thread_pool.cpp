@@ -0,0 +1,47 @@
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(std::size_t threadCount) : stopping(false) {
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+std::size_t ThreadPool::getThreadCount() const {
+    return workers.size();
+}
+
+std::size_t ThreadPool::hardwareThreadCount() {
+    unsigned int count = std::thread::hardware_concurrency();
+    return count == 0 ? 1 : count;
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            // Drain remaining tasks before shutting down
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+// Fixed-size pool of worker threads executing submitted tasks in FIFO order
+class ThreadPool {
+public:
+    explicit ThreadPool(std::size_t threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Queue a task; its result (or exception) is delivered through the future
+    template <typename Task>
+    std::future<typename std::result_of<Task()>::type> submit(Task task);
+
+    std::size_t getThreadCount() const;
+
+    // Number of hardware threads, at least 1
+    static std::size_t hardwareThreadCount();
+
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping;
+
+    void workerLoop();
+};
+
+template <typename Task>
+std::future<typename std::result_of<Task()>::type> ThreadPool::submit(Task task) {
+    typedef typename std::result_of<Task()>::type Result;
+
+    // packaged_task is move-only, std::function needs a copyable target
+    std::shared_ptr<std::packaged_task<Result()>> packaged =
+        std::make_shared<std::packaged_task<Result()>>(std::move(task));
+    std::future<Result> result = packaged->get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push([packaged]() { (*packaged)(); });
+    }
+    available.notify_one();
+    return result;
+}
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,235 @@
+#include <cstring>
+#include <vector>
+#include "trace_writer.h"
+
+static const char MAGIC[4] = { 'S', 'I', 'M', 'T' };
+
+// Records decoded per read of an event log
+static const std::size_t DECODE_BATCH = 1 << 14;
+
+static const std::string STATE_NAMES[] = {
+    processStateToString(ProcessState::NEW),
+    processStateToString(ProcessState::READY),
+    processStateToString(ProcessState::RUNNING),
+    processStateToString(ProcessState::BLOCKED),
+    processStateToString(ProcessState::TERMINATED)
+};
+
+static const int STATE_COUNT = sizeof(STATE_NAMES) / sizeof(STATE_NAMES[0]);
+static const int REASON_COUNT = static_cast<int>(TraceReason::TERMINATION) + 1;
+
+// Records of version 1 logs, whose time is an int32
+static const std::size_t VERSION_1_RECORD_SIZE = 12;
+
+static inline void appendInt(std::string& out, long long value) {
+    char digits[21];
+    char* end = digits + sizeof(digits);
+    char* p = end;
+    unsigned long long magnitude = value < 0 ? 0ull - static_cast<unsigned long long>(value)
+                                             : static_cast<unsigned long long>(value);
+    do {
+        *--p = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0) {
+        *--p = '-';
+    }
+    out.append(p, end - p);
+}
+
+static inline void appendUnsigned(std::string& out, unsigned long long value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+static inline unsigned long long readUnsigned(const char* p, int bytes) {
+    unsigned long long value = 0;
+    for (int i = bytes - 1; i >= 0; --i) {
+        value = (value << 8) | static_cast<unsigned char>(p[i]);
+    }
+    return value;
+}
+
+AsyncWriter::AsyncWriter(std::ostream& out)
+    : out(out), writing(false), stopping(false), thread(&AsyncWriter::writerLoop, this) {}
+
+AsyncWriter::~AsyncWriter() {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    thread.join();
+    out.flush();
+}
+
+void AsyncWriter::write(std::string&& block) {
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this]() { return pending.size() < MAX_PENDING_BLOCKS; });
+    pending.push_back(std::move(block));
+    changed.notify_all();
+}
+
+void AsyncWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this]() { return pending.empty() && !writing; });
+    out.flush();
+}
+
+void AsyncWriter::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        changed.wait(lock, [this]() { return stopping || !pending.empty(); });
+        if (pending.empty()) {
+            return;
+        }
+        std::string block = std::move(pending.front());
+        pending.pop_front();
+        writing = true;
+        changed.notify_all();
+
+        // The stream is only touched here while blocks are pending
+        lock.unlock();
+        out.write(block.data(), block.size());
+        lock.lock();
+        writing = false;
+        changed.notify_all();
+    }
+}
+
+TraceWriter::TraceWriter(std::ostream& out, Format format, bool asynchronous)
+    : out(out), format(format) {
+    if (asynchronous) {
+        writer.reset(new AsyncWriter(out));
+    }
+    block.reserve(BLOCK_SIZE);
+}
+
+TraceWriter::~TraceWriter() {
+    flush();
+}
+
+void TraceWriter::record(const TraceRecord& record) {
+    if (format == Format::TEXT) {
+        appendText(record);
+    } else {
+        appendBinary(record);
+    }
+    if (block.size() >= BLOCK_SIZE) {
+        if (writer) {
+            writer->write(std::move(block));
+            block = std::string();
+            block.reserve(BLOCK_SIZE);
+        } else {
+            out.write(block.data(), block.size());
+            block.clear();
+        }
+    }
+}
+
+void TraceWriter::flush() {
+    if (writer) {
+        if (!block.empty()) {
+            writer->write(std::move(block));
+            block = std::string();
+            block.reserve(BLOCK_SIZE);
+        }
+        writer->flush();
+    } else {
+        out.write(block.data(), block.size());
+        block.clear();
+        out.flush();
+    }
+}
+
+void TraceWriter::appendText(const TraceRecord& record) {
+    block.append("At time ");
+    appendInt(block, record.time);
+    block.append(": Process ");
+    appendInt(block, record.processId);
+    block.append(" moves from ");
+    block.append(STATE_NAMES[static_cast<int>(record.from)]);
+    block.append(" to ");
+    block.append(STATE_NAMES[static_cast<int>(record.to)]);
+    switch (record.reason) {
+        case TraceReason::PREEMPTION:
+            block.append(" (preempted)");
+            break;
+        case TraceReason::TIME_SLICE_EXPIRATION:
+            block.append(" (time slice expired)");
+            break;
+        case TraceReason::DISPATCH:
+            if (record.core >= 0) {
+                block.append(" on CPU ");
+                appendInt(block, record.core);
+            }
+            break;
+        default:
+            break;
+    }
+    block.push_back('\n');
+}
+
+void TraceWriter::appendBinary(const TraceRecord& record) {
+    appendUnsigned(block, static_cast<unsigned long long>(record.time), 8);
+    appendUnsigned(block, static_cast<unsigned int>(record.processId), 4);
+    appendUnsigned(block, static_cast<unsigned int>(record.core), 2);
+    block.push_back(static_cast<char>(static_cast<int>(record.from) << 4 | static_cast<int>(record.to)));
+    block.push_back(static_cast<char>(record.reason));
+}
+
+void EventLog::writeHeader(std::ostream& out) {
+    std::string header(MAGIC, sizeof(MAGIC));
+    appendUnsigned(header, VERSION, 4);
+    out.write(header.data(), header.size());
+}
+
+bool EventLog::decode(std::istream& in, std::ostream& out, std::string& error) {
+    char header[HEADER_SIZE];
+    if (!in.read(header, HEADER_SIZE) || std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0) {
+        error = "Not an event log";
+        return false;
+    }
+    unsigned int version = static_cast<unsigned int>(readUnsigned(header + 4, 4));
+    if (version != 1 && version != VERSION) {
+        error = "Unsupported event log version " + std::to_string(version);
+        return false;
+    }
+    std::size_t recordSize = version == 1 ? VERSION_1_RECORD_SIZE : RECORD_SIZE;
+    int timeBytes = version == 1 ? 4 : 8;
+
+    // Decoding goes through a synchronous writer so the text is identical
+    TraceWriter text(out, TraceWriter::Format::TEXT, false);
+    std::vector<char> buffer(DECODE_BATCH * recordSize);
+    unsigned long long decoded = 0;
+    while (in) {
+        in.read(buffer.data(), buffer.size());
+        std::size_t size = static_cast<std::size_t>(in.gcount());
+        if (size % recordSize != 0) {
+            error = "Truncated event log after " + std::to_string(decoded + size / recordSize) + " records";
+            return false;
+        }
+        for (const char* p = buffer.data(); p < buffer.data() + size; p += recordSize) {
+            TraceRecord record;
+            record.time = timeBytes == 4 ? static_cast<int>(readUnsigned(p, 4))
+                                         : static_cast<SimTime>(readUnsigned(p, 8));
+            const char* fields = p + timeBytes;
+            record.processId = static_cast<int>(readUnsigned(fields, 4));
+            record.core = static_cast<short>(readUnsigned(fields + 4, 2));
+            int from = static_cast<unsigned char>(fields[6]) >> 4;
+            int to = static_cast<unsigned char>(fields[6]) & 0xF;
+            int reason = static_cast<unsigned char>(fields[7]);
+            if (from >= STATE_COUNT || to >= STATE_COUNT || reason >= REASON_COUNT) {
+                error = "Corrupt event log record " + std::to_string(decoded + 1);
+                return false;
+            }
+            record.from = static_cast<ProcessState>(from);
+            record.to = static_cast<ProcessState>(to);
+            record.reason = static_cast<TraceReason>(reason);
+            text.record(record);
+            decoded++;
+        }
+    }
+    return true;
+}
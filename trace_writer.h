@@ -0,0 +1,118 @@
+#ifndef TRACE_WRITER_H
+#define TRACE_WRITER_H
+
+#include <string>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <istream>
+#include <ostream>
+#include <cstddef>
+#include "types.h"
+
+// Why a process changed state; it selects the suffix of the text line
+enum class TraceReason : unsigned char {
+    ARRIVAL,
+    DISPATCH,
+    PREEMPTION,
+    TIME_SLICE_EXPIRATION,
+    IO_REQUEST,
+    IO_COMPLETION,
+    TERMINATION
+};
+
+// One state transition of a process; core is the CPU a dispatch went to,
+// -1 when it is not reported (other transitions, single-CPU runs)
+struct TraceRecord {
+    SimTime time;
+    int processId;
+    ProcessState from;
+    ProcessState to;
+    TraceReason reason;
+    int core;
+};
+
+// Writes blocks to a stream on a background thread, in the order they were
+// handed over. At most a few blocks wait at a time; beyond that write blocks
+// the caller, so a slow stream cannot make the backlog grow without bound.
+class AsyncWriter {
+public:
+    explicit AsyncWriter(std::ostream& out);
+    ~AsyncWriter();
+
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+    void write(std::string&& block);
+
+    // Wait until every block is written, then flush the stream
+    void flush();
+
+private:
+    static const std::size_t MAX_PENDING_BLOCKS = 4;
+
+    std::ostream& out;
+    std::deque<std::string> pending;
+    bool writing;
+    bool stopping;
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::thread thread;
+
+    void writerLoop();
+};
+
+// Sink for the state transitions of simulation runs. Records are formatted
+// into a large block, either as the verbose text lines or in the binary event
+// log format, and the block is written when full, by a background thread
+// unless the writer is synchronous. The text is written only on flush or
+// when the block fills, so a run must flush before anything else goes to the
+// same stream.
+class TraceWriter {
+public:
+    enum class Format { TEXT, BINARY };
+
+    TraceWriter(std::ostream& out, Format format, bool asynchronous = true);
+    ~TraceWriter();
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    void record(const TraceRecord& record);
+
+    // Hand over the current block and wait until everything is written
+    void flush();
+
+private:
+    static const std::size_t BLOCK_SIZE = 1 << 20;
+
+    std::ostream& out;
+    Format format;
+    std::unique_ptr<AsyncWriter> writer;
+    std::string block;
+
+    void appendText(const TraceRecord& record);
+    void appendBinary(const TraceRecord& record);
+};
+
+// Binary event log: a header ("SIMT", uint32 version) followed by 16-byte
+// little-endian records (int64 time, int32 process id, int16 core,
+// uint8 from << 4 | to, uint8 reason). Records of several runs follow each
+// other without separators. Version 1 logs, with 12-byte records and an
+// int32 time, are still decoded.
+class EventLog {
+public:
+    static const unsigned int VERSION = 2;
+    static const std::size_t HEADER_SIZE = 8;
+    static const std::size_t RECORD_SIZE = 16;
+
+    static void writeHeader(std::ostream& out);
+
+    // Print the verbose text lines of every record; returns false with a
+    // message in error on a bad header or a truncated or corrupt record
+    static bool decode(std::istream& in, std::ostream& out, std::string& error);
+};
+
+#endif // TRACE_WRITER_H
@@ -2,6 +2,10 @@
 #define TYPES_H
 
 #include <string>
+#include <vector>
+
+// Simulated time in time units; 64-bit so month-long traces cannot overflow
+typedef long long SimTime;
 
 // Enum for process state
 enum class ProcessState {
@@ -24,8 +28,8 @@ inline std::string processStateToString(ProcessState state) {
     }
 }
 
-// Enum for burst type
-enum class BurstType {
+// Enum for burst type (one byte, it is stored per burst)
+enum class BurstType : unsigned char {
     CPU,
     IO
 };
@@ -51,16 +55,176 @@ inline std::string eventTypeToString(EventType type) {
     }
 }
 
+// Check a positive decimal number without leading zeros that fits an int
+inline bool isPositiveNumber(const std::string& text) {
+    if (text.empty() || text.size() > 9 || text[0] == '0') return false;
+    for (char c : text) {
+        if (c < '0' || c > '9') return false;
+    }
+    return true;
+}
+
+// Service order of the queue of a shared I/O device: first come first
+// served, or the shortest burst first (the counterpart of shortest seek
+// time first for devices without a geometry)
+enum class DeviceDiscipline {
+    FCFS,
+    SSTF
+};
+
+// Parse a device setting: "<count>[:fcfs|:sstf]", FCFS by default
+inline bool parseDevices(const std::string& text, int& count, DeviceDiscipline& discipline) {
+    std::string::size_type colon = text.find(':');
+    std::string number = text.substr(0, colon);
+    std::string order = colon == std::string::npos ? "fcfs" : text.substr(colon + 1);
+    if (!isPositiveNumber(number)) return false;
+    if (order == "fcfs") {
+        discipline = DeviceDiscipline::FCFS;
+    } else if (order == "sstf") {
+        discipline = DeviceDiscipline::SSTF;
+    } else {
+        return false;
+    }
+    count = std::stoi(number);
+    return true;
+}
+
+// Parse a multilevel feedback queue name: "MLFQ" (10/20/40:1000) or
+// "MLFQ<q0>/<q1>/...[:<boost>]", the time quantum of each level from the
+// highest and the period of the priority boost
+inline bool parseMlfq(const std::string& alg, std::vector<int>& quanta, int& boostPeriod) {
+    if (alg.substr(0, 4) != "MLFQ") return false;
+    std::string settings = alg.substr(4);
+    if (settings.empty()) settings = "10/20/40:1000";
+    std::string::size_type colon = settings.find(':');
+    std::string boost = colon == std::string::npos ? "1000" : settings.substr(colon + 1);
+    if (!isPositiveNumber(boost)) return false;
+    boostPeriod = std::stoi(boost);
+    quanta.clear();
+    std::string levels = settings.substr(0, colon);
+    std::string::size_type start = 0;
+    while (true) {
+        std::string::size_type slash = levels.find('/', start);
+        std::string quantum = levels.substr(start, slash == std::string::npos ? std::string::npos : slash - start);
+        if (!isPositiveNumber(quantum)) return false;
+        quanta.push_back(std::stoi(quantum));
+        if (slash == std::string::npos) break;
+        start = slash + 1;
+    }
+    return quanta.size() <= 32;
+}
+
+// Parse a completely fair scheduler name: "CFS" (80/10) or
+// "CFS<latency>/<granularity>", the target latency and the minimum
+// granularity, which also bounds wake-up preemption
+inline bool parseCfs(const std::string& alg, int& targetLatency, int& minimumGranularity) {
+    if (alg.substr(0, 3) != "CFS") return false;
+    std::string settings = alg.size() == 3 ? "80/10" : alg.substr(3);
+    std::string::size_type slash = settings.find('/');
+    if (slash == std::string::npos) return false;
+    std::string latency = settings.substr(0, slash);
+    std::string granularity = settings.substr(slash + 1);
+    if (!isPositiveNumber(latency) || !isPositiveNumber(granularity)) return false;
+    targetLatency = std::stoi(latency);
+    minimumGranularity = std::stoi(granularity);
+    return true;
+}
+
+// Parse a proportional-share name, prefix (LOTTERY or STRIDE) followed by an
+// optional time quantum (default 10)
+inline bool parseShareQuantum(const std::string& alg, const std::string& prefix, int& quantum) {
+    if (alg.substr(0, prefix.size()) != prefix) return false;
+    std::string settings = alg.size() == prefix.size() ? "10" : alg.substr(prefix.size());
+    if (!isPositiveNumber(settings)) return false;
+    quantum = std::stoi(settings);
+    return true;
+}
+
+// Parse a priority scheduling name: "PRIO" or the preemptive "PPRIO",
+// followed by an optional aging interval (default 100, 0 for no aging)
+inline bool parsePriority(const std::string& alg, bool& preemptive, int& agingInterval) {
+    std::string::size_type prefix;
+    if (alg.substr(0, 5) == "PPRIO") {
+        preemptive = true;
+        prefix = 5;
+    } else if (alg.substr(0, 4) == "PRIO") {
+        preemptive = false;
+        prefix = 4;
+    } else {
+        return false;
+    }
+    std::string settings = alg.size() == prefix ? "100" : alg.substr(prefix);
+    if (settings != "0" && !isPositiveNumber(settings)) return false;
+    agingInterval = std::stoi(settings);
+    return true;
+}
+
+// Policies that share the CPUs out by weight, whose runs report fairness
+inline bool isProportionalShare(const std::string& alg) {
+    int value;
+    int granularity;
+    return parseShareQuantum(alg, "LOTTERY", value) || parseShareQuantum(alg, "STRIDE", value) ||
+           parseCfs(alg, value, granularity);
+}
+
+// Policies with per-process priorities, whose runs report waits per priority
+inline bool isPriorityScheduling(const std::string& alg) {
+    bool preemptive;
+    int agingInterval;
+    return parsePriority(alg, preemptive, agingInterval);
+}
+
 // String representation of scheduling algorithms
 inline std::string algorithmToString(const std::string& alg) {
     if (alg == "FCFS") return "First Come First Serve";
     if (alg == "SJF") return "Shortest Job First";
     if (alg == "SRTN") return "Shortest Remaining Time Next";
+    if (alg == "EDF") return "Earliest Deadline First";
+    if (alg == "RM") return "Rate Monotonic";
     if (alg.substr(0, 2) == "RR") {
         std::string quantum = alg.substr(2);
         return "Round Robin (Quantum " + quantum + ")";
     }
+    std::vector<int> quanta;
+    int boostPeriod;
+    if (parseMlfq(alg, quanta, boostPeriod)) {
+        std::string levels;
+        for (int quantum : quanta) {
+            levels += (levels.empty() ? "" : "/") + std::to_string(quantum);
+        }
+        return "Multi-Level Feedback Queue (Quanta " + levels + ", Boost " + std::to_string(boostPeriod) + ")";
+    }
+    int targetLatency;
+    int minimumGranularity;
+    if (parseCfs(alg, targetLatency, minimumGranularity)) {
+        return "Completely Fair Scheduler (Latency " + std::to_string(targetLatency) + ", Granularity " +
+               std::to_string(minimumGranularity) + ")";
+    }
+    int quantum;
+    if (parseShareQuantum(alg, "LOTTERY", quantum)) {
+        return "Lottery (Quantum " + std::to_string(quantum) + ")";
+    }
+    if (parseShareQuantum(alg, "STRIDE", quantum)) {
+        return "Stride (Quantum " + std::to_string(quantum) + ")";
+    }
+    bool preemptive;
+    int agingInterval;
+    if (parsePriority(alg, preemptive, agingInterval)) {
+        return std::string(preemptive ? "Preemptive Priority" : "Priority") +
+               (agingInterval == 0 ? " (No Aging)" : " (Aging " + std::to_string(agingInterval) + ")");
+    }
     return "Unknown Algorithm";
 }
 
+// Check an algorithm name: FCFS, SJF, SRTN, EDF, RM, RR followed by a
+// positive quantum, or MLFQ, CFS, LOTTERY, STRIDE, PRIO or PPRIO with their
+// optional settings
+inline bool isValidAlgorithm(const std::string& alg) {
+    if (alg == "FCFS" || alg == "SJF" || alg == "SRTN" || alg == "EDF" || alg == "RM") return true;
+    if (alg.substr(0, 2) == "RR") return isPositiveNumber(alg.substr(2));
+    std::vector<int> quanta;
+    int boostPeriod;
+    return parseMlfq(alg, quanta, boostPeriod) || isProportionalShare(alg) || isPriorityScheduling(alg);
+}
+
 #endif // TYPES_H
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "workload.h"
+
+Process& Workload::addProcess(int id, SimTime arrivalTime) {
+    processes.emplace_back(id, arrivalTime);
+    processes.back().setBursts(static_cast<int>(bursts.size()), 0);
+    return processes.back();
+}
+
+void Workload::addBurst(BurstType type, int duration, int device) {
+    bursts.add(type, duration, device);
+    Process& process = processes.back();
+    process.setBursts(process.getFirstBurst(), process.getBurstCount() + 1);
+}
+
+void Workload::reserve(std::size_t processCount, std::size_t burstCount) {
+    processes.reserve(processCount);
+    bursts.reserve(burstCount);
+}
+
+std::size_t Workload::size() const {
+    return processes.size();
+}
+
+bool Workload::empty() const {
+    return processes.empty();
+}
+
+void Workload::clear() {
+    processes.clear();
+    bursts.clear();
+}
+
+void Workload::reset() {
+    for (auto& process : processes) {
+        process.reset();
+    }
+    bursts.reset();
+}
+
+std::vector<Process>& Workload::getProcesses() {
+    return processes;
+}
+
+const std::vector<Process>& Workload::getProcesses() const {
+    return processes;
+}
+
+BurstArena& Workload::getBursts() {
+    return bursts;
+}
+
+const BurstArena& Workload::getBursts() const {
+    return bursts;
+}
@@ -0,0 +1,35 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <vector>
+#include <cstddef>
+#include "process.h"
+#include "burst_arena.h"
+
+// The processes of one simulation input, with the bursts of all of them in a
+// single arena. Built process by process: bursts added after addProcess
+// belong to the process added last.
+class Workload {
+public:
+    Process& addProcess(int id, SimTime arrivalTime);
+    void addBurst(BurstType type, int duration, int device = BurstArena::ANY_DEVICE);
+
+    void reserve(std::size_t processCount, std::size_t burstCount);
+    std::size_t size() const;
+    bool empty() const;
+    void clear();
+
+    // Restore every process and burst to its state before a simulation
+    void reset();
+
+    std::vector<Process>& getProcesses();
+    const std::vector<Process>& getProcesses() const;
+    BurstArena& getBursts();
+    const BurstArena& getBursts() const;
+
+private:
+    std::vector<Process> processes;
+    BurstArena bursts;
+};
+
+#endif // WORKLOAD_H
@@ -0,0 +1,342 @@
+#include <algorithm>
+#include <cstring>
+#include "workload_format.h"
+
+static const char MAGIC[BinaryWorkload::MAGIC_SIZE] = { 'S', 'I', 'M', 'W' };
+
+// Size of the staging buffer used when writing columns
+static const std::size_t WRITE_CHUNK = 1 << 16;
+
+static inline unsigned long long readUnsigned(const char* p, int bytes) {
+    unsigned long long value = 0;
+    for (int i = bytes - 1; i >= 0; --i) {
+        value = (value << 8) | static_cast<unsigned char>(p[i]);
+    }
+    return value;
+}
+
+static inline void appendInt(std::string& out, long long value) {
+    char digits[21];
+    char* end = digits + sizeof(digits);
+    char* p = end;
+    unsigned long long magnitude = value < 0 ? 0ull - static_cast<unsigned long long>(value)
+                                             : static_cast<unsigned long long>(value);
+    do {
+        *--p = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0) {
+        *--p = '-';
+    }
+    out.append(p, end - p);
+}
+
+static inline int readInt32(const char* p) {
+    return static_cast<int>(static_cast<unsigned int>(readUnsigned(p, 4)));
+}
+
+// Little-endian output staged in fixed-size chunks
+class ColumnWriter {
+public:
+    explicit ColumnWriter(std::ostream& out) : out(out) {
+        buffer.reserve(WRITE_CHUNK);
+    }
+
+    ~ColumnWriter() {
+        flush();
+    }
+
+    void putUnsigned(unsigned long long value, int bytes) {
+        if (buffer.size() + bytes > WRITE_CHUNK) {
+            flush();
+        }
+        for (int i = 0; i < bytes; ++i) {
+            buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    void putInt32(int value) {
+        putUnsigned(static_cast<unsigned int>(value), 4);
+    }
+
+    void flush() {
+        out.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+
+private:
+    std::ostream& out;
+    std::vector<char> buffer;
+};
+
+// Columns of the binary format, in file order
+enum Column {
+    IDS, ARRIVALS, BURST_COUNTS, SHARES, PRIORITIES, DEADLINES, PERIODS, DURATIONS, TYPES, DEVICES, COLUMN_COUNT
+};
+
+// Append one column of a workload's processes or bursts
+static void putColumn(ColumnWriter& writer, const Workload& workload, Column column) {
+    const BurstArena& bursts = workload.getBursts();
+    for (const auto& process : workload.getProcesses()) {
+        switch (column) {
+            case IDS:
+                writer.putInt32(process.getId());
+                break;
+            case ARRIVALS:
+                writer.putUnsigned(static_cast<unsigned long long>(process.getArrivalTime()), 8);
+                break;
+            case BURST_COUNTS:
+                writer.putInt32(process.getBurstCount());
+                break;
+            case SHARES:
+                writer.putInt32(process.getWeight());
+                break;
+            case PRIORITIES:
+                writer.putInt32(process.getPriority());
+                break;
+            case DEADLINES:
+                writer.putInt32(process.getDeadline());
+                break;
+            case PERIODS:
+                writer.putInt32(process.getPeriod());
+                break;
+            case DURATIONS:
+                for (int b = process.getFirstBurst(); b < process.getFirstBurst() + process.getBurstCount(); ++b) {
+                    writer.putInt32(bursts.getDuration(b));
+                }
+                break;
+            case TYPES:
+                for (int b = process.getFirstBurst(); b < process.getFirstBurst() + process.getBurstCount(); ++b) {
+                    writer.putUnsigned(bursts.getType(b) == BurstType::CPU ? 0 : 1, 1);
+                }
+                break;
+            case DEVICES:
+                for (int b = process.getFirstBurst(); b < process.getFirstBurst() + process.getBurstCount(); ++b) {
+                    writer.putUnsigned(bursts.getDevice(b), 1);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void TextWorkload::write(std::ostream& out, const Workload& workload, int processSwitchOverhead) {
+    out << workload.size() << " " << processSwitchOverhead << "\n";
+    writeProcesses(out, workload);
+}
+
+void TextWorkload::writeProcesses(std::ostream& out, const Workload& workload) {
+    // Lines are formatted into a chunk by hand; operator<< per field costs
+    // more than generating the workload
+    const BurstArena& bursts = workload.getBursts();
+    std::string text;
+    text.reserve(WRITE_CHUNK + 64);
+    for (const auto& process : workload.getProcesses()) {
+        int count = process.getBurstCount();
+        int first = process.getFirstBurst();
+        appendInt(text, process.getId());
+        text.push_back(' ');
+        appendInt(text, process.getArrivalTime());
+        text.push_back(' ');
+        appendInt(text, count / 2 + 1);
+        // Optional fields up to the last one that is not the default, which
+        // needs every field before it
+        const int optional[] = { process.getWeight(), process.getPriority(), process.getDeadline(),
+                                 process.getPeriod() };
+        const int defaults[] = { Process::DEFAULT_WEIGHT, 0, 0, 0 };
+        int fields = 4;
+        while (fields > 0 && optional[fields - 1] == defaults[fields - 1]) {
+            fields--;
+        }
+        for (int f = 0; f < fields; ++f) {
+            text.push_back(' ');
+            appendInt(text, optional[f]);
+        }
+        text.push_back('\n');
+
+        for (int i = 0; i < count; ++i) {
+            if (bursts.getType(first + i) == BurstType::CPU) {
+                int burstNum = (i / 2) + 1;
+                appendInt(text, burstNum);
+                text.push_back(' ');
+                appendInt(text, bursts.getDuration(first + i));
+
+                // The IO time of the last burst is written as 0 so the line
+                // still has the three fields the parser expects; the device
+                // follows only when the IO burst names one
+                text.push_back(' ');
+                appendInt(text, i + 1 < count ? bursts.getDuration(first + i + 1) : 0);
+                if (i + 1 < count && bursts.getDevice(first + i + 1) != BurstArena::ANY_DEVICE) {
+                    text.push_back(' ');
+                    appendInt(text, bursts.getDevice(first + i + 1));
+                }
+                text.push_back('\n');
+
+                if (text.size() >= WRITE_CHUNK) {
+                    out.write(text.data(), text.size());
+                    text.clear();
+                }
+            }
+        }
+    }
+    out.write(text.data(), text.size());
+    out.flush();
+}
+
+bool BinaryWorkload::matches(const char* data, std::size_t size) {
+    return size >= MAGIC_SIZE && std::memcmp(data, MAGIC, MAGIC_SIZE) == 0;
+}
+
+bool BinaryWorkload::decodeHeader(const char* data, unsigned long long fileSize,
+                                  BinaryWorkloadHeader& header, std::string& error) {
+    if (fileSize < HEADER_SIZE || !matches(data, fileSize)) {
+        error = "Invalid binary workload: truncated header";
+        return false;
+    }
+    unsigned int version = static_cast<unsigned int>(readUnsigned(data + 4, 4));
+    if (version < 1 || version > VERSION) {
+        error = "Unsupported binary workload version " + std::to_string(version);
+        return false;
+    }
+    header.processSwitchOverhead = readInt32(data + 8);
+    header.arrivalBytes = version == 1 ? 4 : 8;
+    header.shareBytes = version < 3 ? 0 : 4;
+    header.priorityBytes = version < 4 ? 0 : 4;
+    header.deadlineBytes = version < 5 ? 0 : 4;
+    header.deviceBytes = version < 6 ? 0 : 1;
+    header.processCount = readUnsigned(data + 16, 8);
+    header.burstCount = readUnsigned(data + 24, 8);
+
+    // Every column must be present in full and nothing may follow them
+    unsigned long long available = fileSize - HEADER_SIZE;
+    unsigned long long processBytes =
+        8 + header.arrivalBytes + header.shareBytes + header.priorityBytes + 2 * header.deadlineBytes;
+    unsigned long long burstBytes = 5 + header.deviceBytes;
+    if (header.processCount > available / processBytes ||
+        header.burstCount > (available - header.processCount * processBytes) / burstBytes ||
+        header.processCount * processBytes + header.burstCount * burstBytes != available) {
+        error = "Invalid binary workload: column sizes do not match the file size";
+        return false;
+    }
+    return true;
+}
+
+bool BinaryWorkload::decode(const char* data, std::size_t size, Workload& workload,
+                            int& processSwitchOverhead, std::string& error) {
+    BinaryWorkloadHeader header;
+    if (!decodeHeader(data, size, header, error)) {
+        return false;
+    }
+    unsigned long long processCount = header.processCount;
+    unsigned long long burstCount = header.burstCount;
+
+    const char* ids = data + HEADER_SIZE;
+    const char* arrivals = ids + processCount * 4;
+    const char* burstCounts = arrivals + processCount * header.arrivalBytes;
+    const char* shares = burstCounts + processCount * 4;
+    const char* priorities = shares + processCount * header.shareBytes;
+    const char* deadlines = priorities + processCount * header.priorityBytes;
+    const char* periods = deadlines + processCount * header.deadlineBytes;
+    const char* durations = periods + processCount * header.deadlineBytes;
+    const char* types = durations + burstCount * 4;
+    const char* devices = types + burstCount;
+
+    Workload decoded;
+    decoded.reserve(processCount, burstCount);
+    unsigned long long burst = 0;
+    for (unsigned long long i = 0; i < processCount; ++i) {
+        int count = readInt32(burstCounts + i * 4);
+        if (count < 0 || static_cast<unsigned long long>(count) > burstCount - burst) {
+            error = "Invalid binary workload: burst counts exceed the burst column";
+            return false;
+        }
+
+        SimTime arrival = header.arrivalBytes == 4
+                              ? readInt32(arrivals + i * 4)
+                              : static_cast<SimTime>(readUnsigned(arrivals + i * 8, 8));
+        int weight = header.shareBytes == 0 ? Process::DEFAULT_WEIGHT : readInt32(shares + i * 4);
+        if (weight < 1 || weight > Process::MAX_WEIGHT) {
+            error = "Invalid binary workload: share out of range";
+            return false;
+        }
+        int priority = header.priorityBytes == 0 ? 0 : readInt32(priorities + i * 4);
+        if (priority < 0 || priority >= Process::PRIORITY_LEVELS) {
+            error = "Invalid binary workload: priority out of range";
+            return false;
+        }
+        int deadline = header.deadlineBytes == 0 ? 0 : readInt32(deadlines + i * 4);
+        int period = header.deadlineBytes == 0 ? 0 : readInt32(periods + i * 4);
+        if (deadline < 0 || period < 0) {
+            error = "Invalid binary workload: negative deadline or period";
+            return false;
+        }
+        Process& process = decoded.addProcess(readInt32(ids + i * 4), arrival);
+        process.setWeight(weight);
+        process.setPriority(priority);
+        process.setDeadline(deadline);
+        process.setPeriod(period);
+        for (int b = 0; b < count; ++b, ++burst) {
+            int device = header.deviceBytes == 0 ? BurstArena::ANY_DEVICE
+                                                 : static_cast<unsigned char>(devices[burst]);
+            decoded.addBurst(types[burst] == 0 ? BurstType::CPU : BurstType::IO, readInt32(durations + burst * 4),
+                             device);
+        }
+    }
+    if (burst != burstCount) {
+        error = "Invalid binary workload: burst counts do not cover the burst column";
+        return false;
+    }
+
+    std::swap(workload, decoded);
+    processSwitchOverhead = header.processSwitchOverhead;
+    return true;
+}
+
+void BinaryWorkload::write(std::ostream& out, const Workload& workload, int processSwitchOverhead) {
+    BinaryWorkloadHeader header = { processSwitchOverhead, 8, 4, 4, 4, 1, workload.size(), 0 };
+    for (const auto& process : workload.getProcesses()) {
+        header.burstCount += process.getBurstCount();
+    }
+
+    writeHeader(out, header);
+    ColumnWriter writer(out);
+    for (int column = 0; column < COLUMN_COUNT; ++column) {
+        putColumn(writer, workload, static_cast<Column>(column));
+    }
+    writer.flush();
+    out.flush();
+}
+
+void BinaryWorkload::writeHeader(std::ostream& out, const BinaryWorkloadHeader& header) {
+    ColumnWriter writer(out);
+    out.write(MAGIC, MAGIC_SIZE);
+    writer.putUnsigned(VERSION, 4);
+    writer.putInt32(header.processSwitchOverhead);
+    writer.putUnsigned(0, 4);
+    writer.putUnsigned(header.processCount, 8);
+    writer.putUnsigned(header.burstCount, 8);
+}
+
+void BinaryWorkload::writeBlock(std::ostream& out, const BinaryWorkloadHeader& header, const Workload& block,
+                                unsigned long long firstProcess, unsigned long long firstBurst) {
+    unsigned long long n = header.processCount;
+    unsigned long long m = header.burstCount;
+    const unsigned long long offsets[COLUMN_COUNT] = {
+        HEADER_SIZE + firstProcess * 4,
+        HEADER_SIZE + n * 4 + firstProcess * 8,
+        HEADER_SIZE + n * 12 + firstProcess * 4,
+        HEADER_SIZE + n * 16 + firstProcess * 4,
+        HEADER_SIZE + n * 20 + firstProcess * 4,
+        HEADER_SIZE + n * 24 + firstProcess * 4,
+        HEADER_SIZE + n * 28 + firstProcess * 4,
+        HEADER_SIZE + n * 32 + firstBurst * 4,
+        HEADER_SIZE + n * 32 + m * 4 + firstBurst,
+        HEADER_SIZE + n * 32 + m * 5 + firstBurst
+    };
+    for (int column = 0; column < COLUMN_COUNT; ++column) {
+        out.seekp(static_cast<std::streamoff>(offsets[column]));
+        ColumnWriter writer(out);
+        putColumn(writer, block, static_cast<Column>(column));
+    }
+}
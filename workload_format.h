@@ -0,0 +1,79 @@
+#ifndef WORKLOAD_FORMAT_H
+#define WORKLOAD_FORMAT_H
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include <cstddef>
+#include "workload.h"
+
+// Writer for the text workload format read by InputParser
+class TextWorkload {
+public:
+    static void write(std::ostream& out, const Workload& workload, int processSwitchOverhead);
+
+    // The process lines alone, without the header line
+    static void writeProcesses(std::ostream& out, const Workload& workload);
+};
+
+// Counts stored in the header of a binary workload
+struct BinaryWorkloadHeader {
+    int processSwitchOverhead;
+    int arrivalBytes;       // Width of an arrival time: 8, or 4 in version 1 files
+    int shareBytes;         // Width of a share: 4, or 0 (no column) before version 3
+    int priorityBytes;      // Width of a priority: 4, or 0 (no column) before version 4
+    int deadlineBytes;      // Width of a deadline and of a period: 4, or 0 before version 5
+    int deviceBytes;        // Width of a burst device: 1, or 0 before version 6
+    unsigned long long processCount;
+    unsigned long long burstCount;
+};
+
+// Versioned binary columnar workload file. All fields are little-endian.
+//
+//   header   "SIMW", uint32 version, int32 process switch overhead,
+//            uint32 reserved (0), uint64 process count n, uint64 burst count m
+//   columns  int32 id[n], int64 arrival time[n], int32 burst count[n],
+//            int32 share[n], int32 priority[n], int32 deadline[n],
+//            int32 period[n], int32 burst duration[m],
+//            uint8 burst type[m] (0 CPU, 1 IO),
+//            uint8 burst device[m] (255 any device)
+//
+// The bursts of all processes are stored back to back in process order.
+// Readers reject versions they do not know; new columns bump the version.
+// Version 1 files, whose arrival times are int32, version 2 files, without
+// shares (every process has the default), version 3 files, without
+// priorities (every process has priority 0), version 4 files, without
+// deadlines and periods (none), and version 5 files, without burst devices
+// (any device), are still read.
+class BinaryWorkload {
+public:
+    static const unsigned int VERSION = 6;
+
+    // True if the data starts with the binary format's magic
+    static bool matches(const char* data, std::size_t size);
+
+    // Decode and check the header of a file of the given size; data must
+    // hold the first HEADER_SIZE bytes (or the whole file if it is shorter)
+    static bool decodeHeader(const char* data, unsigned long long fileSize, BinaryWorkloadHeader& header,
+                             std::string& error);
+
+    // Decode a complete file held in memory; returns false with a message
+    // in error if it is truncated, inconsistent or of an unknown version
+    static bool decode(const char* data, std::size_t size, Workload& workload,
+                       int& processSwitchOverhead, std::string& error);
+
+    static void write(std::ostream& out, const Workload& workload, int processSwitchOverhead);
+
+    // Incremental writing of a file whose counts are known in advance: the
+    // header, then blocks of consecutive processes. A block starts at the
+    // given process and burst positions and writes its part of every column,
+    // so the stream must be seekable; blocks may come in any order.
+    static void writeHeader(std::ostream& out, const BinaryWorkloadHeader& header);
+    static void writeBlock(std::ostream& out, const BinaryWorkloadHeader& header, const Workload& block,
+                           unsigned long long firstProcess, unsigned long long firstBurst);
+
+    static const std::size_t MAGIC_SIZE = 4;
+    static const std::size_t HEADER_SIZE = 32;
+};
+
+#endif // WORKLOAD_FORMAT_H
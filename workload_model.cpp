@@ -0,0 +1,286 @@
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include "workload_model.h"
+
+static const unsigned long long GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+static const double PI = 3.14159265358979323846;
+
+// SplitMix64 finalizer
+static inline unsigned long long mix64(unsigned long long z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+CounterRandom::CounterRandom(unsigned long long seed, unsigned long long process, unsigned int stream)
+    : key(mix64(mix64(seed + GOLDEN_GAMMA) + (process << 2 | stream))), counter(0) {}
+
+unsigned long long CounterRandom::next() {
+    return mix64(key + GOLDEN_GAMMA * ++counter);
+}
+
+double CounterRandom::nextUnit() {
+    return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+int CounterRandom::nextInt(int low, int high) {
+    unsigned long long range = static_cast<unsigned long long>(static_cast<long long>(high) - low + 1);
+    return low + static_cast<int>(((next() >> 32) * range) >> 32);
+}
+
+double CounterRandom::nextExponential(double mean) {
+    return -mean * std::log(1.0 - nextUnit());
+}
+
+double CounterRandom::nextNormal(double mean, double deviation) {
+    // Box-Muller, one of the pair of values
+    double radius = std::sqrt(-2.0 * std::log(1.0 - nextUnit()));
+    return mean + deviation * radius * std::cos(2.0 * PI * nextUnit());
+}
+
+Distribution::Distribution() : kind(Kind::CONSTANT), a(0.0), b(0.0), c(0.0) {}
+
+Distribution::Distribution(Kind kind, double a, double b, double c) : kind(kind), a(a), b(b), c(c) {}
+
+bool Distribution::parse(const std::string& name, std::istream& parameters, std::string& error) {
+    static const struct {
+        const char* name;
+        Kind kind;
+        int parameters;
+    } KINDS[] = {
+        { "constant", Kind::CONSTANT, 1 },
+        { "uniform", Kind::UNIFORM, 2 },
+        { "exponential", Kind::EXPONENTIAL, 1 },
+        { "normal", Kind::NORMAL, 2 },
+        { "pareto", Kind::PARETO, 2 },
+        { "lognormal", Kind::LOGNORMAL, 2 },
+        { "hyperexponential", Kind::HYPEREXPONENTIAL, 3 },
+        { "bimodal", Kind::BIMODAL, 3 },
+    };
+
+    int count = -1;
+    for (const auto& known : KINDS) {
+        if (name == known.name) {
+            kind = known.kind;
+            count = known.parameters;
+        }
+    }
+    if (count < 0) {
+        error = "unknown distribution '" + name + "'";
+        return false;
+    }
+
+    double values[3] = { 0.0, 0.0, 0.0 };
+    for (int i = 0; i < count; ++i) {
+        if (!(parameters >> values[i])) {
+            error = name + " takes " + std::to_string(count) + " parameters";
+            return false;
+        }
+    }
+    std::string extra;
+    if (parameters >> extra) {
+        error = name + " takes " + std::to_string(count) + " parameters";
+        return false;
+    }
+    a = values[0];
+    b = values[1];
+    c = values[2];
+
+    bool valid = true;
+    switch (kind) {
+        case Kind::UNIFORM:
+            valid = a == std::floor(a) && b == std::floor(b) && a <= b;
+            break;
+        case Kind::EXPONENTIAL:
+            valid = a > 0.0;
+            break;
+        case Kind::NORMAL:
+        case Kind::LOGNORMAL:
+            valid = b >= 0.0;
+            break;
+        case Kind::PARETO:
+            valid = a > 0.0 && b > 0.0;
+            break;
+        case Kind::HYPEREXPONENTIAL:
+            valid = a >= 0.0 && a <= 1.0 && b > 0.0 && c > 0.0;
+            break;
+        case Kind::BIMODAL:
+            valid = a >= 0.0 && a <= 1.0;
+            break;
+        default:
+            break;
+    }
+    if (!valid) {
+        error = "parameters out of range for " + name;
+        return false;
+    }
+    return true;
+}
+
+double Distribution::sample(CounterRandom& random) const {
+    switch (kind) {
+        case Kind::UNIFORM:
+            return random.nextInt(static_cast<int>(a), static_cast<int>(b));
+        case Kind::EXPONENTIAL:
+            return random.nextExponential(a);
+        case Kind::NORMAL:
+            return random.nextNormal(a, b);
+        case Kind::PARETO:
+            // Inverse transform; 1 - u is in (0, 1]
+            return a / std::pow(1.0 - random.nextUnit(), 1.0 / b);
+        case Kind::LOGNORMAL:
+            return std::exp(random.nextNormal(a, b));
+        case Kind::HYPEREXPONENTIAL: {
+            double mean = random.nextUnit() < a ? b : c;
+            return random.nextExponential(mean);
+        }
+        case Kind::BIMODAL:
+            return random.nextUnit() < a ? b : c;
+        default:
+            return a;
+    }
+}
+
+WorkloadModel::WorkloadModel()
+    : arrival(Distribution::Kind::EXPONENTIAL, 50.0),   // Mean of 50 time units
+      cpuBurst(Distribution::Kind::UNIFORM, 5, 500),    // 5 to 500 time units
+      ioBurst(Distribution::Kind::UNIFORM, 30, 1000),   // 30 to 1000 time units
+      burstCount(Distribution::Kind::NORMAL, 20.0, 5.0), // Mean of 20 bursts with standard deviation of 5
+      share(Distribution::Kind::CONSTANT, 1024.0),       // Nice 0 weight
+      priority(Distribution::Kind::CONSTANT, 0.0),       // Highest priority
+      deadline(Distribution::Kind::CONSTANT, 0.0),       // No deadline
+      period(Distribution::Kind::CONSTANT, 0.0),         // No period
+      ioDevice(Distribution::Kind::CONSTANT, -1.0),      // Any device
+      modulated(false) {
+    phaseLengths[0] = 1.0;
+    phaseLengths[1] = 1.0;
+}
+
+bool WorkloadModel::load(const std::string& path) {
+    std::ifstream in(path.c_str());
+    if (!in) {
+        error = "Cannot open workload model " + path;
+        return false;
+    }
+    return parse(in);
+}
+
+bool WorkloadModel::parse(std::istream& in) {
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        std::string::size_type comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        std::istringstream fields(line);
+        std::string setting;
+        if (!(fields >> setting)) {
+            continue;
+        }
+        std::string name;
+        fields >> name;
+
+        std::string problem;
+        bool parsed = true;
+        if (setting == "arrival" && name == "mmpp") {
+            double values[4];
+            for (double& value : values) {
+                parsed = parsed && static_cast<bool>(fields >> value);
+            }
+            std::string extra;
+            if (!parsed || fields >> extra || values[0] <= 0.0 || values[1] <= 0.0 || values[2] < 1.0 ||
+                values[3] < 1.0) {
+                parsed = false;
+                problem = "mmpp takes two positive mean interarrival times and two phase lengths of at least 1";
+            } else {
+                modulated = true;
+                phaseArrivals[0] = Distribution(Distribution::Kind::EXPONENTIAL, values[0]);
+                phaseArrivals[1] = Distribution(Distribution::Kind::EXPONENTIAL, values[1]);
+                phaseLengths[0] = values[2];
+                phaseLengths[1] = values[3];
+            }
+        } else if (setting == "arrival") {
+            parsed = arrival.parse(name, fields, problem);
+            modulated = false;
+        } else if (setting == "cpu_burst") {
+            parsed = cpuBurst.parse(name, fields, problem);
+        } else if (setting == "io_burst") {
+            parsed = ioBurst.parse(name, fields, problem);
+        } else if (setting == "burst_count") {
+            parsed = burstCount.parse(name, fields, problem);
+        } else if (setting == "share") {
+            parsed = share.parse(name, fields, problem);
+        } else if (setting == "priority") {
+            parsed = priority.parse(name, fields, problem);
+        } else if (setting == "deadline") {
+            parsed = deadline.parse(name, fields, problem);
+        } else if (setting == "period") {
+            parsed = period.parse(name, fields, problem);
+        } else if (setting == "io_device") {
+            parsed = ioDevice.parse(name, fields, problem);
+        } else {
+            parsed = false;
+            problem = "unknown setting '" + setting + "'";
+        }
+        if (!parsed) {
+            error = "Error in workload model line " + std::to_string(lineNumber) + ": " + problem;
+            return false;
+        }
+    }
+    return true;
+}
+
+const std::string& WorkloadModel::getError() const {
+    return error;
+}
+
+const Distribution& WorkloadModel::getArrival() const {
+    return arrival;
+}
+
+const Distribution& WorkloadModel::getCpuBurst() const {
+    return cpuBurst;
+}
+
+const Distribution& WorkloadModel::getIoBurst() const {
+    return ioBurst;
+}
+
+const Distribution& WorkloadModel::getBurstCount() const {
+    return burstCount;
+}
+
+const Distribution& WorkloadModel::getShare() const {
+    return share;
+}
+
+const Distribution& WorkloadModel::getPriority() const {
+    return priority;
+}
+
+const Distribution& WorkloadModel::getDeadline() const {
+    return deadline;
+}
+
+const Distribution& WorkloadModel::getPeriod() const {
+    return period;
+}
+
+const Distribution& WorkloadModel::getIoDevice() const {
+    return ioDevice;
+}
+
+bool WorkloadModel::isModulated() const {
+    return modulated;
+}
+
+const Distribution& WorkloadModel::getPhaseArrival(int phase) const {
+    return phaseArrivals[phase];
+}
+
+double WorkloadModel::getPhaseLength(int phase) const {
+    return phaseLengths[phase];
+}
@@ -0,0 +1,129 @@
+#ifndef WORKLOAD_MODEL_H
+#define WORKLOAD_MODEL_H
+
+#include <string>
+#include <istream>
+
+// Counter-based random numbers: draw n of a stream is a SplitMix64 hash of
+// (seed, process, stream, n), so every process can be generated on its own,
+// on any thread, with the same result. The distributions are implemented
+// here rather than taken from <random>, whose algorithms differ between
+// standard libraries.
+class CounterRandom {
+public:
+    CounterRandom(unsigned long long seed, unsigned long long process, unsigned int stream);
+
+    // 64 random bits
+    unsigned long long next();
+
+    // Uniform in [0, 1)
+    double nextUnit();
+
+    // Uniform in [low, high]
+    int nextInt(int low, int high);
+
+    double nextExponential(double mean);
+    double nextNormal(double mean, double deviation);
+
+private:
+    unsigned long long key;
+    unsigned long long counter;
+};
+
+// One distribution of a workload model, as written in a model file:
+//
+//   constant value
+//   uniform low high                  integers in [low, high]
+//   exponential mean
+//   normal mean deviation
+//   pareto minimum shape              heavy tail, infinite variance for shape <= 2
+//   lognormal mu sigma                of the underlying normal
+//   hyperexponential p mean1 mean2    exponential(mean1) with probability p,
+//                                     else exponential(mean2)
+//   bimodal p value1 value2           value1 with probability p, else value2
+class Distribution {
+public:
+    enum class Kind { CONSTANT, UNIFORM, EXPONENTIAL, NORMAL, PARETO, LOGNORMAL, HYPEREXPONENTIAL, BIMODAL };
+
+    Distribution();
+    Distribution(Kind kind, double a, double b = 0.0, double c = 0.0);
+
+    // Set from a distribution name and the stream of its parameters; false
+    // with a message in error if the name is unknown or a parameter is
+    // missing, extra or out of range
+    bool parse(const std::string& name, std::istream& parameters, std::string& error);
+
+    double sample(CounterRandom& random) const;
+
+private:
+    Kind kind;
+    double a;
+    double b;
+    double c;
+};
+
+// Distributions of generated workloads, read from a model file with one
+// setting per line ('#' starts a comment):
+//
+//   arrival      <distribution>       interarrival time
+//   arrival      mmpp mean1 mean2 phase1 phase2
+//   cpu_burst    <distribution>
+//   io_burst     <distribution>
+//   burst_count  <distribution>       rounded, then made odd (ends with CPU)
+//   share        <distribution>       tickets or weight, rounded
+//   priority     <distribution>       rounded, clamped to 0 (highest) to 63
+//   deadline     <distribution>       relative deadline, 0 for none
+//   period       <distribution>       0 for none
+//   io_device    <distribution>       device of every I/O burst, rounded,
+//                                     clamped to 0 to 254, -1 for any
+//
+// mmpp arrivals alternate between two phases, each lasting a geometric
+// number of arrivals (mean phase1 or phase2) with exponential interarrival
+// times of mean mean1 or mean2: a Markov-modulated Poisson process counted
+// in arrivals, which gives bursty arrivals. Settings left out keep the
+// defaults: exponential arrivals (mean 50), uniform CPU bursts 5 to 500 and
+// I/O bursts 30 to 1000, normal burst count (mean 20, deviation 5), a
+// constant share of 1024, priority 0, no deadline or period and I/O on any
+// device.
+class WorkloadModel {
+public:
+    WorkloadModel();
+
+    // Read a model; returns false on the first bad line (see getError)
+    bool load(const std::string& path);
+    bool parse(std::istream& in);
+
+    const std::string& getError() const;
+
+    const Distribution& getArrival() const;
+    const Distribution& getCpuBurst() const;
+    const Distribution& getIoBurst() const;
+    const Distribution& getBurstCount() const;
+    const Distribution& getShare() const;
+    const Distribution& getPriority() const;
+    const Distribution& getDeadline() const;
+    const Distribution& getPeriod() const;
+    const Distribution& getIoDevice() const;
+
+    // Markov-modulated arrivals; the phase distributions replace getArrival
+    bool isModulated() const;
+    const Distribution& getPhaseArrival(int phase) const;
+    double getPhaseLength(int phase) const;
+
+private:
+    Distribution arrival;
+    Distribution cpuBurst;
+    Distribution ioBurst;
+    Distribution burstCount;
+    Distribution share;
+    Distribution priority;
+    Distribution deadline;
+    Distribution period;
+    Distribution ioDevice;
+    bool modulated;
+    Distribution phaseArrivals[2];
+    double phaseLengths[2];
+    std::string error;
+};
+
+#endif // WORKLOAD_MODEL_H